@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <deque>
+
+#include <Animator.h>
+
+namespace {
+    constexpr size_t trackCount{100000};
+
+    /**
+     * @brief 每帧采样全部活动轨道
+     * @details range(0) 为驱动的分量[Value/Position/Rotation], range(1) 为是否使用缓动表;
+     * 每条轨道 4 个关键帧循环播放, 起始时间错开, 使各轨道所在区间不同
+     */
+    void animatorUpdate(benchmark::State& state) {
+        const auto channel = static_cast<Animator::Channel>(state.range(0));
+        Animator animator{};
+        const Animator::Easing easing = state.range(1) != 0 ? animator.addEasing(Bezier({0.25f, 0.1f}, {0.25f, 1.0f})) : Animator::linear;
+        TransformPool pool{};
+        std::deque<Transform> transforms{};
+        std::vector<float> values(trackCount);
+        for (size_t i = 0; i < trackCount; i++) {
+            const float offset = -static_cast<float>(i % 97) * 0.031f;
+            if (channel == Animator::Channel::Value) {
+                Animator::Builder(animator, values[i])
+                    .key(0.0f, 0.0f, easing).key(1.0f, 1.0f, easing).key(2.0f, 4.0f, easing).key(3.0f, 0.0f)
+                    .playback(Animator::Playback::Loop).delay(offset).build();
+            } else if (channel == Animator::Channel::Rotation) {
+                Animator::Builder(animator, transforms.emplace_back(pool), channel)
+                    .key(0.0f, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), easing)
+                    .key(1.0f, glm::quat(0.70710678f, 0.0f, 0.70710678f, 0.0f), easing)
+                    .key(2.0f, glm::quat(0.0f, 0.0f, 1.0f, 0.0f), easing)
+                    .key(3.0f, glm::quat(0.70710678f, 0.70710678f, 0.0f, 0.0f))
+                    .playback(Animator::Playback::Loop).delay(offset).build();
+            } else {
+                Animator::Builder(animator, transforms.emplace_back(pool), channel)
+                    .key(0.0f, glm::vec3(0.0f), easing).key(1.0f, glm::vec3(1.0f, 0.0f, 0.0f), easing)
+                    .key(2.0f, glm::vec3(1.0f, 1.0f, 0.0f), easing).key(3.0f, glm::vec3(0.0f))
+                    .playback(Animator::Playback::Loop).delay(offset).build();
+            }
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(animator.update(1.0f / 60.0f));
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * trackCount));
+    }
+}
+
+BENCHMARK(animatorUpdate)
+    ->ArgNames({"channel", "eased"})
+    ->ArgsProduct({{
+        static_cast<int64_t>(Animator::Channel::Value),
+        static_cast<int64_t>(Animator::Channel::Position),
+        static_cast<int64_t>(Animator::Channel::Rotation)
+    }, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
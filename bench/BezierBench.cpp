@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+
+#include <Bezier.h>
+#include <BezierTable.h>
+
+namespace {
+    constexpr size_t sampleCount{4096};
+
+    /**
+     * @brief 缓动曲线
+     * @details 0 为 CSS ease, 1 为两端平缓中段陡峭的曲线[牛顿迭代收敛最慢]
+     */
+    const Bezier& curve(const int64_t index) {
+        static const Bezier curves[2]{Bezier({0.25f, 0.1f}, {0.25f, 1.0f}), Bezier({0.9f, 0.0f}, {0.1f, 1.0f})};
+        return curves[index];
+    }
+
+    const std::vector<float>& samples() {
+        static const std::vector<float> out = [] {
+            std::vector<float> x(sampleCount);
+            for (size_t i = 0; i < sampleCount; i++) {
+                x[i] = (static_cast<float>(i) + 0.5f) / static_cast<float>(sampleCount);
+            }
+            return x;
+        }();
+        return out;
+    }
+
+    /**
+     * @brief 参考缓动值
+     * @details 以 double 二分 60 次求逆, 不依赖牛顿迭代的收敛
+     */
+    std::vector<double> reference(const Bezier& bezier) {
+        std::vector<double> out{};
+        for (const float x : samples()) {
+            double l{0.0}, r{1.0};
+            for (size_t i = 0; i < 60; i++) {
+                const double m = (l + r) / 2;
+                (bezier.x(m) > x ? r : l) = m;
+            }
+            out.push_back(bezier.y((l + r) / 2));
+        }
+        return out;
+    }
+
+    double maxError(const std::vector<double>& expected, const std::vector<float>& actual) {
+        double out{0.0};
+        for (size_t i = 0; i < expected.size(); i++) {
+            out = std::max(out, std::fabs(expected[i] - actual[i]));
+        }
+        return out;
+    }
+
+    void report(benchmark::State& state, const std::vector<float>& out) {
+        state.counters["maxError"] = maxError(reference(curve(state.range(0))), out);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sampleCount));
+    }
+
+    /**
+     * @brief 逐个以 double 求逆后求值
+     * @details range(0) 为曲线, range(1) 为牛顿迭代次数
+     */
+    void bezierScalar(benchmark::State& state) {
+        const Bezier& bezier = curve(state.range(0));
+        const auto accuracy = static_cast<size_t>(state.range(1));
+        const auto& x = samples();
+        std::vector<float> out(sampleCount);
+        for (auto _ : state) {
+            for (size_t i = 0; i < sampleCount; i++) {
+                out[i] = static_cast<float>(bezier.y(bezier.inverse_x(x[i], accuracy)));
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        report(state, out);
+    }
+
+    /**
+     * @brief 批量以 float 求逆后求值
+     * @details 参数同 bezierScalar
+     */
+    void bezierBatch(benchmark::State& state) {
+        const Bezier& bezier = curve(state.range(0));
+        const auto accuracy = static_cast<size_t>(state.range(1));
+        const auto& x = samples();
+        std::vector<float> t(sampleCount), out(sampleCount);
+        for (auto _ : state) {
+            bezier.inverse_x(x.data(), t.data(), sampleCount, accuracy);
+            bezier.y(t.data(), out.data(), sampleCount);
+            benchmark::DoNotOptimize(out.data());
+        }
+        report(state, out);
+    }
+
+    /**
+     * @brief 查找表
+     * @details range(0) 为曲线, range(1) 为表大小, range(2) 为插值方式
+     */
+    void bezierTable(benchmark::State& state) {
+        const BezierTable table(curve(state.range(0)), static_cast<size_t>(state.range(1)), static_cast<BezierTable::Interpolation>(state.range(2)));
+        const auto& x = samples();
+        std::vector<float> out(sampleCount);
+        for (auto _ : state) {
+            table.get(x.data(), out.data(), sampleCount);
+            benchmark::DoNotOptimize(out.data());
+        }
+        report(state, out);
+    }
+}
+
+BENCHMARK(bezierScalar)
+    ->ArgNames({"curve", "accuracy"})
+    ->ArgsProduct({{0, 1}, {1, 3, 5}});
+
+BENCHMARK(bezierBatch)
+    ->ArgNames({"curve", "accuracy"})
+    ->ArgsProduct({{0, 1}, {1, 3, 5}});
+
+BENCHMARK(bezierTable)
+    ->ArgNames({"curve", "size", "interpolation"})
+    ->ArgsProduct({{0, 1}, {64, 256, 1024}, {
+        static_cast<int64_t>(BezierTable::Interpolation::Linear),
+        static_cast<int64_t>(BezierTable::Interpolation::Cubic)
+    }});
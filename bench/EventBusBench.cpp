@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include <EventBus.hpp>
+
+namespace {
+    struct Move {
+        double x;
+        double y;
+    };
+
+    /**
+     * @brief 同步发布延迟
+     * @details range(0) 为订阅者数量, range(1) 为是否使用预先计算的标识符哈希;
+     * 总线上另有 20 个无关分组, 使二分查找不至于退化为单元素
+     */
+    void eventBusPublish(benchmark::State& state) {
+        const auto subscribers = static_cast<size_t>(state.range(0));
+        EventBus bus{};
+        double sink{0.0};
+        for (size_t i = 0; i < 20; i++) {
+            bus.subscribe<int>("other-" + std::to_string(i), [](int&) {});
+        }
+        for (size_t i = 0; i < subscribers; i++) {
+            bus.subscribe<Move>("mouse-move-callback", [&sink](Move& e) { sink += e.x; });
+        }
+        const std::string identifier{"mouse-move-callback"};
+        constexpr EventBus::Topic topic = EventBus::topic("mouse-move-callback");
+        Move move{0.0, 0.0};
+        for (auto _ : state) {
+            move.x += 1.0;
+            if (state.range(1) != 0) {
+                bus.publish(topic, move);
+            } else {
+                bus.publish(identifier, move);
+            }
+        }
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.counters["callbacks"] = benchmark::Counter(static_cast<double>(state.iterations() * subscribers), benchmark::Counter::kIsRate);
+    }
+
+    /**
+     * @brief 排队投递并逐帧处理
+     * @details 每次迭代投递 range(0) 个事件后 dispatch 一次, 单订阅者
+     */
+    void eventBusPostDispatch(benchmark::State& state) {
+        const auto batch = static_cast<size_t>(state.range(0));
+        EventBus bus(batch);
+        double sink{0.0};
+        bus.subscribe<Move>("mouse-move-callback", [&sink](Move& e) { sink += e.x; });
+        constexpr EventBus::Topic topic = EventBus::topic("mouse-move-callback");
+        Move move{0.0, 0.0};
+        for (auto _ : state) {
+            for (size_t i = 0; i < batch; i++) {
+                move.x += 1.0;
+                bus.post(topic, move);
+            }
+            benchmark::DoNotOptimize(bus.dispatch());
+        }
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch));
+    }
+}
+
+BENCHMARK(eventBusPublish)
+    ->ArgNames({"subscribers", "prehashed"})
+    ->ArgsProduct({{1, 10, 100}, {0, 1}});
+
+BENCHMARK(eventBusPostDispatch)
+    ->ArgNames({"batch"})
+    ->Arg(64)
+    ->Arg(1024);
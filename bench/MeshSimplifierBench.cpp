@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include <MeshSimplifier.h>
+#include <SyntheticMesh.hpp>
+
+namespace {
+    /**
+     * @brief 单次简化的吞吐
+     * @details range(0) 为每边格点数, range(1) 为目标三角形比例[百分比]; 吞吐以输入三角形计, 额外报告实际比例与误差
+     */
+    void simplify(benchmark::State& state) {
+        const auto layout = bench::gridModel(static_cast<size_t>(state.range(0)), false);
+        const auto& indices = layout.bufferOfIndices();
+        const std::vector<float>& vertices = layout.WeldIndices();
+        const size_t stride = layout.elements()[0].step / sizeof(float);
+        const size_t target = indices.size() * static_cast<size_t>(state.range(1)) / 300 * 3;
+        std::vector<unsigned int> out{};
+        float error{0.0f};
+        for (auto _ : state) {
+            out = MeshSimplifier::simplify(indices, vertices.data(), vertices.size() / stride, stride, 0, target, {}, &error);
+            benchmark::DoNotOptimize(out);
+        }
+        state.counters["triangles"] = benchmark::Counter(static_cast<double>(state.iterations() * indices.size() / 3), benchmark::Counter::kIsRate);
+        state.counters["ratio"] = static_cast<double>(out.size()) / static_cast<double>(indices.size());
+        state.counters["error"] = error;
+    }
+
+    /**
+     * @brief 默认比例的细节层次链
+     * @details range(0) 为每边格点数, 吞吐以原始网格三角形计
+     */
+    void lodChain(benchmark::State& state) {
+        const auto layout = bench::gridModel(static_cast<size_t>(state.range(0)), false);
+        const size_t triangleCount = layout.bufferOfIndices().size() / 3;
+        for (auto _ : state) {
+            auto chain = MeshSimplifier::buildLodChain(layout);
+            benchmark::DoNotOptimize(chain);
+        }
+        state.counters["triangles"] = benchmark::Counter(static_cast<double>(state.iterations() * triangleCount), benchmark::Counter::kIsRate);
+    }
+}
+
+BENCHMARK(simplify)
+    ->ArgNames({"grid", "percent"})
+    ->ArgsProduct({{128, 512}, {50, 10}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(lodChain)
+    ->ArgName("grid")
+    ->Arg(128)
+    ->Arg(512)
+    ->Unit(benchmark::kMillisecond);
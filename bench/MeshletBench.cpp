@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <MeshletBuilder.h>
+#include <SyntheticMesh.hpp>
+
+namespace {
+    /**
+     * @brief 单个对象的网格簇切分
+     * @details range(0) 为每边格点数, range(1) 为是否先经 MeshOptimizer 重排; 额外报告簇数与平均每簇顶点数
+     */
+    void meshletBuild(benchmark::State& state) {
+        const auto layout = bench::gridModel(static_cast<size_t>(state.range(0)), state.range(1) != 0);
+        const size_t triangleCount = layout.bufferOfIndices().size() / 3;
+        MeshletBuilder::MeshletMesh mesh{};
+        for (auto _ : state) {
+            mesh = MeshletBuilder::build(layout);
+            benchmark::DoNotOptimize(mesh);
+        }
+        state.counters["triangles"] = benchmark::Counter(static_cast<double>(state.iterations() * triangleCount), benchmark::Counter::kIsRate);
+        state.counters["meshlets"] = static_cast<double>(mesh.meshlets.size());
+        state.counters["verticesPerMeshlet"] = mesh.meshlets.empty() ? 0.0 : static_cast<double>(mesh.vertices.size()) / static_cast<double>(mesh.meshlets.size());
+    }
+
+    /**
+     * @brief 多个对象的多线程网格簇切分
+     * @details 8 个 256 x 256 对象, range(0) 为线程数[0 表示硬件并发数]
+     */
+    void meshletBuildModels(benchmark::State& state) {
+        std::map<std::string, VertexLayout<float>> models{};
+        size_t triangleCount{0};
+        for (size_t i = 0; i < 8; i++) {
+            auto layout = bench::gridModel(256, true);
+            triangleCount += layout.bufferOfIndices().size() / 3;
+            models.emplace("grid" + std::to_string(i), std::move(layout));
+        }
+        for (auto _ : state) {
+            auto meshes = MeshletBuilder::build(models, static_cast<size_t>(state.range(0)));
+            benchmark::DoNotOptimize(meshes);
+        }
+        state.counters["triangles"] = benchmark::Counter(static_cast<double>(state.iterations() * triangleCount), benchmark::Counter::kIsRate);
+    }
+}
+
+BENCHMARK(meshletBuild)
+    ->ArgNames({"grid", "optimized"})
+    ->ArgsProduct({{128, 512}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(meshletBuildModels)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(0)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
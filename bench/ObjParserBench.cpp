@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include <ModelParser.h>
+#include <SyntheticMesh.hpp>
+
+namespace {
+    /**
+     * @brief 各解析后端在同一模型源上的吞吐
+     * @details range(0) 为后端, range(1) 为模型源[0: resource/model/default.obj, 1: 512 x 512 合成网格]
+     */
+    void objParse(benchmark::State& state) {
+        static const std::string sources[2]{bench::readResource("model/default.obj"), bench::gridObj(512)};
+        const auto backend = static_cast<ModelParser::ObjBackend>(state.range(0));
+        const std::string& source = sources[state.range(1)];
+        if (source.empty()) {
+            state.SkipWithError("模型源为空");
+            return;
+        }
+        for (auto _ : state) {
+            auto models = ModelParser::ObjModelLoader(source, backend);
+            benchmark::DoNotOptimize(models);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+    }
+}
+
+BENCHMARK(objParse)
+    ->ArgNames({"backend", "source"})
+    ->ArgsProduct({{
+        static_cast<int64_t>(ModelParser::ObjBackend::Stream),
+        static_cast<int64_t>(ModelParser::ObjBackend::Scan),
+        static_cast<int64_t>(ModelParser::ObjBackend::ParallelScan)
+    }, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
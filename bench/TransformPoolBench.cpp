@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <TransformPool.h>
+
+namespace {
+    constexpr size_t transformCount{1 << 16};
+
+    /**
+     * @brief 填充一个全部为脏的变换池
+     * @details range(0) 为存放格式, range(1) 为逆变换所占百分比
+     */
+    std::vector<TransformPool::Handle> fill(TransformPool& pool, const benchmark::State& state) {
+        std::vector<TransformPool::Handle> out(transformCount);
+        const auto inverseCount = static_cast<size_t>(state.range(1)) * transformCount / 100;
+        for (size_t i = 0; i < transformCount; i++) {
+            out[i] = pool.allocate();
+            const float f = static_cast<float>(i);
+            pool.setPosition(out[i], {f, f * 0.5f, -f});
+            pool.setRotation(out[i], glm::quat(0.92387953f, 0.0f, 0.38268343f, 0.0f));
+            pool.setScale(out[i], {1.5f, 0.5f, 2.0f});
+            pool.setOrigin(out[i], {0.5f, 0.0f, 0.5f});
+            // 交错分布, 使每组内都混有正逆变换
+            pool.setInverse(out[i], i * inverseCount / transformCount != (i + 1) * inverseCount / transformCount);
+        }
+        return out;
+    }
+
+    /**
+     * @brief 批量合成
+     * @details 每次迭代先标记全部槽位为脏, 再整体 update
+     */
+    void poolUpdate(benchmark::State& state) {
+        TransformPool pool(static_cast<TransformPool::Storage>(state.range(0)));
+        const auto handles = fill(pool, state);
+        float x{0.0f};
+        for (auto _ : state) {
+            x += 1.0f;
+            for (const auto e : handles) {
+                pool.setPosition(e, {x, 0.0f, 0.0f});
+            }
+            pool.update();
+            benchmark::DoNotOptimize(pool.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * transformCount));
+    }
+
+    /**
+     * @brief 逐个以标量路径合成
+     * @details 与 poolUpdate 相同的工作量, 通过 rows 逐个触发合成
+     */
+    void poolScalar(benchmark::State& state) {
+        TransformPool pool(static_cast<TransformPool::Storage>(state.range(0)));
+        const auto handles = fill(pool, state);
+        float x{0.0f};
+        for (auto _ : state) {
+            x += 1.0f;
+            for (const auto e : handles) {
+                pool.setPosition(e, {x, 0.0f, 0.0f});
+                benchmark::DoNotOptimize(pool.rows(e));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * transformCount));
+    }
+}
+
+BENCHMARK(poolUpdate)
+    ->ArgNames({"storage", "inversePercent"})
+    ->ArgsProduct({{
+        static_cast<int64_t>(TransformPool::Storage::Matrix4x4),
+        static_cast<int64_t>(TransformPool::Storage::Matrix3x4)
+    }, {0, 50, 100}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(poolScalar)
+    ->ArgNames({"storage", "inversePercent"})
+    ->ArgsProduct({{
+        static_cast<int64_t>(TransformPool::Storage::Matrix4x4),
+        static_cast<int64_t>(TransformPool::Storage::Matrix3x4)
+    }, {0, 50, 100}})
+    ->Unit(benchmark::kMicrosecond);
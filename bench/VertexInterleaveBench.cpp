@@ -0,0 +1,134 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <StaticVertexFormat.hpp>
+#include <VertexInterleave.hpp>
+
+namespace {
+    constexpr size_t vertexCount{1 << 20};
+
+    /**
+     * @brief 1M 顶点的 3 + 2 + 3 源列与按伪随机顺序引用它们的 1M 个面角
+     */
+    struct Mesh {
+        std::vector<float> positions, texCoords, normals;
+        std::vector<unsigned int> indices;
+        std::vector<interleave::Column<float>> columns;
+
+        Mesh() {
+            positions.resize(vertexCount * 3);
+            texCoords.resize(vertexCount * 2);
+            normals.resize(vertexCount * 3);
+            for (size_t i = 0; i < positions.size(); i++) {
+                positions[i] = static_cast<float>(i) * 0.25f;
+                normals[i] = static_cast<float>(i % 7) * 0.125f;
+            }
+            for (size_t i = 0; i < texCoords.size(); i++) {
+                texCoords[i] = static_cast<float>(i % 1024) / 1024.0f;
+            }
+            indices.resize(vertexCount * 3);
+            uint32_t state{12345};
+            for (size_t c = 0; c < vertexCount; c++) {
+                state = state * 1664525u + 1013904223u;
+                const unsigned int v = state % vertexCount;
+                std::fill_n(indices.begin() + static_cast<ptrdiff_t>(c * 3), 3, v);
+            }
+            columns = {{positions.data(), 3, positions.size()}, {texCoords.data(), 2, texCoords.size()}, {normals.data(), 3, normals.size()}};
+        }
+    };
+
+    const Mesh& mesh() {
+        static const Mesh instance{};
+        return instance;
+    }
+
+    /**
+     * @brief 交错内核之前的 assemblyBuffer 实现
+     * @details 每个元素先 insert 扩容再 copy_n, 用作对照
+     */
+    void legacySequential(const std::vector<interleave::Column<float>>& columns, std::vector<float>& cache) {
+        size_t size{0};
+        for (const auto& e : columns) {
+            size += e.count;
+        }
+        cache.clear();
+        cache.reserve(size);
+        size_t step{0}, i{0};
+        while (i < size) {
+            for (const auto& e : columns) {
+                cache.insert(cache.end(), e.length, 0.0f);
+                std::copy_n(e.source + e.length * step, e.length, cache.begin() + static_cast<ptrdiff_t>(i));
+                i += e.length;
+            }
+            step++;
+        }
+    }
+
+    /**
+     * @brief 交错内核之前的 ExpandIndices 实现
+     * @details 他似乎不需要详细注释[划掉]
+     */
+    void legacyGather(const std::vector<interleave::Column<float>>& columns, const std::vector<unsigned int>& indices, std::vector<float>& cache) {
+        cache.clear();
+        cache.reserve(indices.size() / columns.size() * 8);
+        size_t i{0}, element{0};
+        for (const unsigned int index : indices) {
+            const auto& e = columns[element];
+            cache.insert(cache.end(), e.length, 0.0f);
+            std::copy_n(e.source + e.length * index, e.length, cache.begin() + static_cast<ptrdiff_t>(i));
+            i += e.length;
+            element = (element + 1) % columns.size();
+        }
+    }
+
+    /**
+     * @brief 顺序交错 1M 个顶点
+     * @details range(0) 为 0 时使用旧实现, 为 1 时使用交错内核, 为 2 时使用编译期顶点格式; 吞吐按写出的字节计
+     */
+    void interleaveSequential(benchmark::State& state) {
+        const Mesh& m = mesh();
+        std::vector<float> cache{};
+        for (auto _ : state) {
+            if (state.range(0) == 0) {
+                legacySequential(m.columns, cache);
+            } else if (state.range(0) == 1) {
+                cache.resize(vertexCount * 8);
+                interleave::sequential(m.columns, vertexCount, 8, cache.data());
+            } else {
+                cache.resize(vertexCount * 8);
+                vertex_format::PositionTexCoordNormal::sequential(m.columns, vertexCount, 8, cache.data());
+            }
+            benchmark::DoNotOptimize(cache.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * vertexCount * 8 * sizeof(float)));
+    }
+
+    /**
+     * @brief 按索引交错 1M 个面角
+     * @details range(0) 为 0 时使用旧实现, 为 1 时使用交错内核, 为 2 时使用编译期顶点格式; 吞吐按写出的字节计
+     */
+    void interleaveGather(benchmark::State& state) {
+        const Mesh& m = mesh();
+        std::vector<float> cache{};
+        for (auto _ : state) {
+            if (state.range(0) == 0) {
+                legacyGather(m.columns, m.indices, cache);
+            } else if (state.range(0) == 1) {
+                cache.resize(vertexCount * 8);
+                interleave::gather(m.columns, m.indices.data(), vertexCount, 8, cache.data());
+            } else {
+                cache.resize(vertexCount * 8);
+                vertex_format::PositionTexCoordNormal::gather(m.columns, m.indices.data(), vertexCount, 8, cache.data());
+            }
+            benchmark::DoNotOptimize(cache.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * vertexCount * 8 * sizeof(float)));
+    }
+}
+
+BENCHMARK(interleaveSequential)->ArgName("kernel")->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK(interleaveGather)->ArgName("kernel")->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
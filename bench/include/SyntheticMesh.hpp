@@ -0,0 +1,73 @@
+#pragma once
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <GlobalLogger.hpp>
+#include <ModelParser.h>
+
+namespace bench {
+    /**
+     * @brief 生成网格状 obj 模型源
+     * @details 单个对象, n x n 个格点带起伏高度, 每个格点有 v/vt/vn, 每个格子为两个 v/vt/vn 三角形
+     * @param n 每边格点数
+     * @return obj模型源
+     */
+    inline std::string gridObj(size_t n) {
+        std::string source{"o grid\n"};
+        source.reserve(n * n * 160);
+        char line[128];
+        const float step = 1.0f / static_cast<float>(n - 1);
+        for (size_t y = 0; y < n; y++) {
+            for (size_t x = 0; x < n; x++) {
+                const float u = static_cast<float>(x) * step, v = static_cast<float>(y) * step;
+                const float h = 0.05f * std::sin(u * 12.0f) * std::cos(v * 9.0f);
+                source.append(line, std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", u, h, v));
+                source.append(line, std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", u, v));
+                const float nx = -0.6f * std::cos(u * 12.0f) * std::cos(v * 9.0f), nz = 0.45f * std::sin(u * 12.0f) * std::sin(v * 9.0f);
+                const float length = std::sqrt(nx * nx + 1.0f + nz * nz);
+                source.append(line, std::snprintf(line, sizeof(line), "vn %.6f %.6f %.6f\n", nx / length, 1.0f / length, nz / length));
+            }
+        }
+        for (size_t y = 0; y + 1 < n; y++) {
+            for (size_t x = 0; x + 1 < n; x++) {
+                const size_t a = y * n + x + 1, b = a + 1, c = a + n, d = c + 1;
+                source.append(line, std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", a, a, a, c, c, c, b, b, b));
+                source.append(line, std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", b, b, b, c, c, c, d, d, d));
+            }
+        }
+        return source;
+    }
+
+    /**
+     * @brief 解析网格状 obj 模型源得到的缓冲区组装布局
+     * @details 他似乎不需要详细注释[划掉]
+     * @param n 每边格点数
+     * @param optimize 是否进行网格优化
+     * @return 缓冲区组装布局[焊接组装]
+     */
+    inline VertexLayout<float> gridModel(size_t n, bool optimize) {
+        auto models = ModelParser::ObjModelLoader(gridObj(n), ModelParser::ObjBackend::Scan, optimize);
+        auto& layout = models.begin()->second;
+        layout.WeldIndices();
+        return std::move(layout);
+    }
+
+    /**
+     * @brief 读取资源目录下的文件
+     * @details 他似乎不需要详细注释[划掉]
+     * @param name 相对资源目录的路径
+     * @return 文件内容[无法打开时为空]
+     */
+    inline std::string readResource(const std::string& name) {
+        const std::filesystem::path path = std::filesystem::path(RESOURCE_DIR) / name;
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            glog.log<DefaultLevel::Warn>("错误: 资源文件无法打开: " + path.string());
+            return {};
+        }
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+}
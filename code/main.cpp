@@ -47,11 +47,13 @@ void render() {
         currentTime = glfwGetTime();
         deltaTime = currentTime - lastTime;
         lastTime = currentTime;
+
+        gEbus.dispatch();
     }
 }
 
 int main() {
-    globalLogger::_minLevel = DefaultLevel::Debug;
+    glog.setMinLevel(DefaultLevel::Debug);
     glog.log(DefaultLevel::Info, "程序已启动");
 
     auto& icon = arm.load<ImageResource>("icon", iconPath);
@@ -76,6 +78,7 @@ int main() {
     glfwSetCursorPosCallback(window, event::func::mouse_callback);
     glfwSetMouseButtonCallback(window, event::func::mouse_button_callback);
     glfwSetFramebufferSizeCallback(window, event::func::frameBuffer_size_callback);
+    event::func::coalesce_callbacks();
 
     thread renderThread(render);
 
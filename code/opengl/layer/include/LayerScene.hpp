@@ -59,6 +59,18 @@ class LayerSceneElement {
             return *_sceneElements;
         }
 
+        LayerSceneElement& parent() {
+            return *_parent;
+        }
+
+        const LayerSceneElement& parent() const {
+            return *_parent;
+        }
+
+        [[nodiscard]] size_t depth() const {
+            return _depth;
+        }
+
         Composite& get() {
             return *_value;
         }
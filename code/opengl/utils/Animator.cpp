@@ -0,0 +1,268 @@
+#include "Animator.h"
+#include <cmath>
+#include <string>
+
+#include <GlobalLogger.hpp>
+
+Animator::Builder::Builder(Animator &animator, Transform &target, Channel channel):
+    _animator(&animator),
+    _channel(channel),
+    _target(&target) {
+    if (channel == Channel::Value) {
+        glog.log<DefaultLevel::Warn>("错误: 变换轨道不能驱动 Value 分量");
+        _target = nullptr;
+    }
+}
+
+Animator::Builder::Builder(Animator &animator, float &target):
+    _animator(&animator),
+    _channel(Channel::Value),
+    _target(&target) {
+}
+
+bool Animator::Builder::append(float time, Easing easing, bool matched) {
+    if (!matched) {
+        glog.log<DefaultLevel::Warn>("错误: 关键帧类型与轨道分量不符, 已忽略");
+        return false;
+    }
+    if (!_times.empty() && !(time > _times.back())) {
+        glog.log<DefaultLevel::Warn>("错误: 关键帧时间须严格递增, 已忽略: " + std::to_string(time));
+        return false;
+    }
+    if (easing != linear && easing >= _animator->_tables.size()) {
+        glog.log<DefaultLevel::Warn>("错误: 缓动未注册, 按线性处理: " + std::to_string(easing));
+        easing = linear;
+    }
+    _times.push_back(time);
+    _easings.push_back(easing);
+    return true;
+}
+
+Animator::Builder &Animator::Builder::key(float time, const glm::vec3 &value, Easing easing) {
+    if (append(time, easing, _channel != Channel::Rotation && _channel != Channel::Value)) {
+        _values.insert(_values.end(), {value.x, value.y, value.z, 0.0f});
+    }
+    return *this;
+}
+
+Animator::Builder &Animator::Builder::key(float time, const glm::quat &value, Easing easing) {
+    if (append(time, easing, _channel == Channel::Rotation)) {
+        _values.insert(_values.end(), {value.x, value.y, value.z, value.w});
+    }
+    return *this;
+}
+
+Animator::Builder &Animator::Builder::key(float time, float value, Easing easing) {
+    if (append(time, easing, _channel == Channel::Value)) {
+        _values.insert(_values.end(), {value, 0.0f, 0.0f, 0.0f});
+    }
+    return *this;
+}
+
+Animator::Builder &Animator::Builder::playback(Playback mode) {
+    _playback = mode;
+    return *this;
+}
+
+Animator::Builder &Animator::Builder::delay(float seconds) {
+    _delay = seconds;
+    return *this;
+}
+
+Animator::Builder &Animator::Builder::speed(float factor) {
+    _speed = factor;
+    return *this;
+}
+
+Animator::Track Animator::Builder::build() {
+    if (_target == nullptr || _times.empty()) {
+        glog.log<DefaultLevel::Warn>("错误: 轨道没有目标或关键帧");
+        return invalidTrack;
+    }
+    Animator& a = *_animator;
+    const auto track = static_cast<Track>(a._keyFirst.size());
+    a._keyFirst.push_back(static_cast<uint32_t>(a._keyTimes.size()));
+    a._keyCount.push_back(static_cast<uint32_t>(_times.size()));
+    a._keyTimes.insert(a._keyTimes.end(), _times.begin(), _times.end());
+    a._keyValues.insert(a._keyValues.end(), _values.begin(), _values.end());
+    a._keyEasings.insert(a._keyEasings.end(), _easings.begin(), _easings.end());
+    a._channels.push_back(_channel);
+    a._playbacks.push_back(_playback);
+    a._targets.push_back(_target);
+    a._clocks.push_back(-_delay);
+    a._speeds.push_back(_speed);
+    a._durations.push_back(_times.back() - _times.front());
+    a._cursors.push_back(0);
+    a._slots.push_back(inactive);
+    a.activate(track);
+    return track;
+}
+
+Animator::Easing Animator::addEasing(const Bezier &curve, size_t size, BezierTable::Interpolation interpolation) {
+    _tables.emplace_back(curve, size, interpolation);
+    return static_cast<Easing>(_tables.size() - 1);
+}
+
+size_t Animator::update(float delta) {
+    size_t count{0};
+    for (size_t i = 0; i < _active.size();) {
+        const Track track = _active[i];
+        const float clock = _clocks[track] += delta * _speeds[track];
+        if (clock < 0.0f) {
+            i++;
+            continue;
+        }
+        const float duration = _durations[track];
+        float local = clock;
+        bool finished{false};
+        switch (_playbacks[track]) {
+            case Playback::Once:
+                if (local >= duration) {
+                    local = duration;
+                    finished = true;
+                }
+                break;
+            case Playback::Loop:
+                if (duration > 0.0f && local >= duration) {
+                    local = std::fmod(local, duration);
+                }
+                break;
+            case Playback::PingPong:
+                if (duration > 0.0f) {
+                    local = std::fmod(local, 2.0f * duration);
+                    if (local > duration) local = 2.0f * duration - local;
+                }
+                break;
+        }
+        sample(track, local);
+        count++;
+        // 停止时活动列表末尾的轨道换到当前位置, 不前进
+        if (finished) {
+            deactivate(track);
+        } else {
+            i++;
+        }
+    }
+    return count;
+}
+
+void Animator::sample(Track track, float local) {
+    const uint32_t first = _keyFirst[track];
+    const uint32_t count = _keyCount[track];
+    const float* times = _keyTimes.data() + first;
+    const float time = times[0] + local;
+
+    uint32_t segment{0};
+    float progress{0.0f};
+    if (count > 1) {
+        // 时间通常单调前进, 从上次的区间向后找; 回绕或 seek 回退时从头找
+        segment = _cursors[track];
+        if (time < times[segment]) segment = 0;
+        while (segment + 2 < count && time >= times[segment + 1]) segment++;
+        _cursors[track] = segment;
+        progress = (time - times[segment]) / (times[segment + 1] - times[segment]);
+        progress = progress > 0.0f ? progress : 0.0f;
+        progress = progress < 1.0f ? progress : 1.0f;
+        const Easing easing = _keyEasings[first + segment];
+        if (easing != linear) progress = _tables[easing].get(progress);
+    }
+
+    const float* a = _keyValues.data() + (first + segment) * valueStride;
+    const float* b = count > 1 ? a + valueStride : a;
+    const Channel channel = _channels[track];
+    if (channel == Channel::Value) {
+        *static_cast<float*>(_targets[track]) = a[0] + (b[0] - a[0]) * progress;
+        return;
+    }
+
+    Transform& target = *static_cast<Transform*>(_targets[track]);
+    if (channel == Channel::Rotation) {
+        // 归一化线性插值, 取最短弧
+        const float sign = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.0f ? -1.0f : 1.0f;
+        float q[4];
+        for (size_t k = 0; k < 4; k++) {
+            q[k] = a[k] + (sign * b[k] - a[k]) * progress;
+        }
+        const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+        target.setRotate(glm::quat(q[3] * scale, q[0] * scale, q[1] * scale, q[2] * scale));
+        return;
+    }
+
+    const glm::vec3 value{
+        a[0] + (b[0] - a[0]) * progress,
+        a[1] + (b[1] - a[1]) * progress,
+        a[2] + (b[2] - a[2]) * progress
+    };
+    switch (channel) {
+        case Channel::Position:
+            target.setTranslate(value);
+            break;
+        case Channel::Scale:
+            target.setScale(value);
+            break;
+        case Channel::Origin:
+            target.origin(value);
+            break;
+        default:
+            break;
+    }
+}
+
+void Animator::play(Track track) {
+    if (track < _slots.size()) activate(track);
+}
+
+void Animator::stop(Track track) {
+    if (track < _slots.size()) deactivate(track);
+}
+
+void Animator::seek(Track track, float time) {
+    if (track >= _clocks.size()) return;
+    _clocks[track] = time;
+}
+
+bool Animator::playing(Track track) const {
+    return track < _slots.size() && _slots[track] != inactive;
+}
+
+size_t Animator::size() const {
+    return _keyFirst.size();
+}
+
+size_t Animator::activeCount() const {
+    return _active.size();
+}
+
+void Animator::clear() {
+    _keyTimes.clear();
+    _keyValues.clear();
+    _keyEasings.clear();
+    _keyFirst.clear();
+    _keyCount.clear();
+    _channels.clear();
+    _playbacks.clear();
+    _targets.clear();
+    _clocks.clear();
+    _speeds.clear();
+    _durations.clear();
+    _cursors.clear();
+    _slots.clear();
+    _active.clear();
+}
+
+void Animator::activate(Track track) {
+    if (_slots[track] != inactive) return;
+    _slots[track] = static_cast<uint32_t>(_active.size());
+    _active.push_back(track);
+}
+
+void Animator::deactivate(Track track) {
+    const uint32_t slot = _slots[track];
+    if (slot == inactive) return;
+    const Track last = _active.back();
+    _active[slot] = last;
+    _slots[last] = slot;
+    _active.pop_back();
+    _slots[track] = inactive;
+}
@@ -1,8 +1,112 @@
 #include "Bezier.h"
 
+#include <algorithm>
 #include <iostream>
 #include <glm/ext/quaternion_common.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BEZIER_SSE 1
+#endif
+
+namespace {
+#ifdef BEZIER_SSE
+    /**
+     * @brief 4 个自变量
+     * @details 与 float 提供相同的运算符, 使标量与批量路径共用同一份求值代码
+     */
+    struct Lanes {
+        __m128 v;
+        Lanes() = default;
+        Lanes(const float value): v(_mm_set1_ps(value)) {}
+        explicit Lanes(const __m128 value): v(value) {}
+        explicit Lanes(const float* source): v(_mm_loadu_ps(source)) {}
+    };
+
+    inline Lanes operator + (const Lanes a, const Lanes b) { return Lanes(_mm_add_ps(a.v, b.v)); }
+    inline Lanes operator - (const Lanes a, const Lanes b) { return Lanes(_mm_sub_ps(a.v, b.v)); }
+    inline Lanes operator * (const Lanes a, const Lanes b) { return Lanes(_mm_mul_ps(a.v, b.v)); }
+    inline Lanes operator / (const Lanes a, const Lanes b) { return Lanes(_mm_div_ps(a.v, b.v)); }
+    inline Lanes greater(const Lanes a, const Lanes b) { return Lanes(_mm_cmpgt_ps(a.v, b.v)); }
+    inline Lanes select(const Lanes mask, const Lanes a, const Lanes b) { return Lanes(_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))); }
+    inline Lanes clamp(const Lanes value, const Lanes low, const Lanes high) { return Lanes(_mm_min_ps(_mm_max_ps(value.v, low.v), high.v)); }
+    inline void store(float* target, const Lanes value) { _mm_storeu_ps(target, value.v); }
+#endif
+
+    inline bool greater(const float a, const float b) { return a > b; }
+    inline float select(const bool mask, const float a, const float b) { return mask ? a : b; }
+    inline float clamp(const float value, const float low, const float high) { return std::min(std::max(value, low), high); }
+
+    /**
+     * @brief 单个分量的幂基系数
+     * @details B(t) = ((a * t + b) * t + c) * t + d, 比伯恩斯坦形式少一半乘法
+     */
+    struct Polynomial {
+        float a, b, c, d;
+        float start, end;
+
+        Polynomial(const float s, const float c0, const float c1, const float e):
+            a(e - s + 3.0f * (c0 - c1)),
+            b(3.0f * (s - 2.0f * c0 + c1)),
+            c(3.0f * (c0 - s)),
+            d(s),
+            start(s),
+            end(e) {
+        }
+    };
+
+    template<typename T>
+    inline T evaluate(const Polynomial& p, const T t) {
+        const T zero{0.0f}, one{1.0f};
+        const T u = clamp(t, zero, one);
+        const T value = ((T{p.a} * u + T{p.b}) * u + T{p.c}) * u + T{p.d};
+        // t >= 1 时直接取终点, 与单点版本一样保证端点精确
+        return select(greater(one, t), value, T{p.end});
+    }
+
+    template<typename T>
+    inline T derivative(const Polynomial& p, const T t) {
+        const T u = clamp(t, T{0.0f}, T{1.0f});
+        return (T{3.0f * p.a} * u + T{2.0f * p.b}) * u + T{p.c};
+    }
+
+    /**
+     * @brief 逆函数求解
+     * @details 与 inverse_x 相同: 以端点值为区间二分 3 次后做 accuracy 次牛顿迭代;
+     * 牛顿步限制在二分得到的区间内, 否则端点附近会越出 [0, 1] 落入钳制后的平坦段而只能缓慢爬回
+     */
+    template<typename T>
+    inline T solve(const Polynomial& p, const T target, const size_t accuracy) {
+        const T zero{0.0f}, one{1.0f}, half{0.5f};
+        T l{p.start}, r{p.end};
+        T root{zero};
+        for (uint8_t i = 0; i < 3; i++) {
+            root = l + (r - l) * half;
+            const auto above = greater(evaluate(p, root) - target, zero);
+            r = select(above, root, r);
+            l = select(above, l, root);
+        }
+        for (size_t i = 0; i < accuracy; i++) {
+            root = clamp(root - (evaluate(p, root) - target) / derivative(p, root), l, r);
+        }
+        root = select(greater(target, zero), root, T{p.start});
+        return select(greater(one, target), root, T{p.end});
+    }
+
+    template<typename Kernel>
+    inline void batch(const float* in, float* out, const size_t count, Kernel&& kernel) {
+        size_t i{0};
+#ifdef BEZIER_SSE
+        for (; i + 4 <= count; i += 4) {
+            store(out + i, kernel(Lanes(in + i)));
+        }
+#endif
+        for (; i < count; i++) {
+            out[i] = kernel(in[i]);
+        }
+    }
+}
+
 Bezier::Bezier(const glm::vec2 &start, const glm::vec2 &control0, const glm::vec2 &control1, const glm::vec2 &end):
     _start(start),
     _control0(control0),
@@ -90,7 +194,7 @@ double Bezier::inverse_x(double t, size_t accuracy) const {
     for (size_t i = 0; i < accuracy; i++) {
         double current_x = x(root) - t;
         double current_x_ = derivative_x(root);
-        root = root - current_x / current_x_;
+        root = std::clamp(root - current_x / current_x_, l, r);
     }
     return root;
 }
@@ -113,12 +217,31 @@ double Bezier::inverse_y(double t, size_t accuracy) const {
     for (size_t i = 0; i < accuracy; i++) {
         double current_y = y(root) - t;
         double current_y_ = derivative_y(root);
-        root = root - current_y / current_y_;
+        root = std::clamp(root - current_y / current_y_, l, r);
     }
 
     return root;
 }
 
+void Bezier::x(const float *t, float *out, size_t count) const {
+    const Polynomial p{_start.x, _control0.x, _control1.x, _end.x};
+    batch(t, out, count, [&p](const auto v) { return evaluate(p, v); });
+}
+
+void Bezier::y(const float *t, float *out, size_t count) const {
+    const Polynomial p{_start.y, _control0.y, _control1.y, _end.y};
+    batch(t, out, count, [&p](const auto v) { return evaluate(p, v); });
+}
+
+void Bezier::inverse_x(const float *t, float *out, size_t count, size_t accuracy) const {
+    const Polynomial p{_start.x, _control0.x, _control1.x, _end.x};
+    batch(t, out, count, [&p, accuracy](const auto v) { return solve(p, v, accuracy); });
+}
+
+void Bezier::inverse_y(const float *t, float *out, size_t count, size_t accuracy) const {
+    const Polynomial p{_start.y, _control0.y, _control1.y, _end.y};
+    batch(t, out, count, [&p, accuracy](const auto v) { return solve(p, v, accuracy); });
+}
 
 glm::vec2 Bezier::get(double t) const {
     return {x(t), y(t)};
@@ -0,0 +1,122 @@
+#include "BezierTable.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <GlobalLogger.hpp>
+
+namespace {
+    /**
+     * @brief 求曲线 x 分量取 target 时的自变量
+     * @details 构建时使用, 二分到 double 精度, 不依赖导数
+     */
+    double solve(const Bezier& curve, const double target, const bool increasing) {
+        double l{0.0}, r{1.0};
+        for (uint8_t i = 0; i < 64 && l < r; i++) {
+            const double middle = l + (r - l) / 2;
+            if ((curve.x(middle) < target) == increasing) {
+                l = middle;
+            } else {
+                r = middle;
+            }
+        }
+        return l + (r - l) / 2;
+    }
+
+    /**
+     * @brief Fritsch-Carlson 单调斜率
+     * @details 斜率以采样间隔为单位; 相邻割线异号或为 0 的点斜率取 0, 过大的斜率按半径 3 收缩
+     */
+    std::vector<float> monotoneSlopes(const std::vector<float>& values) {
+        const size_t n = values.size();
+        std::vector<float> deltas(n - 1), slopes(n);
+        for (size_t i = 0; i + 1 < n; i++) {
+            deltas[i] = values[i + 1] - values[i];
+        }
+        slopes.front() = deltas.front();
+        slopes.back() = deltas.back();
+        for (size_t i = 1; i + 1 < n; i++) {
+            slopes[i] = deltas[i - 1] * deltas[i] > 0.0f ? (deltas[i - 1] + deltas[i]) / 2.0f : 0.0f;
+        }
+        for (size_t i = 0; i + 1 < n; i++) {
+            if (deltas[i] == 0.0f) {
+                slopes[i] = slopes[i + 1] = 0.0f;
+                continue;
+            }
+            const float alpha = slopes[i] / deltas[i], beta = slopes[i + 1] / deltas[i];
+            const float radius = alpha * alpha + beta * beta;
+            if (radius > 9.0f) {
+                const float tau = 3.0f / std::sqrt(radius);
+                slopes[i] = tau * alpha * deltas[i];
+                slopes[i + 1] = tau * beta * deltas[i];
+            }
+        }
+        return slopes;
+    }
+}
+
+BezierTable::BezierTable(const Bezier &curve, size_t size, Interpolation interpolation): _interpolation(interpolation) {
+    if (size < 2) {
+        glog.log<DefaultLevel::Warn>("缓动查找表至少需要 2 个采样点, 已按 2 个构建");
+        size = 2;
+    }
+    const double start = curve.x(0.0), end = curve.x(1.0);
+    _start = static_cast<float>(start);
+    _scale = start == end ? 0.0f : static_cast<float>(static_cast<double>(size - 1) / (end - start));
+    _last = size - 2;
+
+    std::vector<float> samples(size);
+    for (size_t i = 0; i < size; i++) {
+        const double target = start + (end - start) * static_cast<double>(i) / static_cast<double>(size - 1);
+        samples[i] = static_cast<float>(curve.y(solve(curve, target, end >= start)));
+    }
+    if (_interpolation == Interpolation::Linear) {
+        _values = std::move(samples);
+        return;
+    }
+
+    // 每个区间以局部坐标 f ∈ [0, 1] 展开为 ((c3 * f + c2) * f + c1) * f + c0
+    const std::vector<float> slopes = monotoneSlopes(samples);
+    _values.resize((size - 1) * 4);
+    for (size_t i = 0; i + 1 < size; i++) {
+        const float delta = samples[i + 1] - samples[i];
+        float* segment = _values.data() + i * 4;
+        segment[0] = samples[i];
+        segment[1] = slopes[i];
+        segment[2] = 3.0f * delta - 2.0f * slopes[i] - slopes[i + 1];
+        segment[3] = slopes[i] + slopes[i + 1] - 2.0f * delta;
+    }
+}
+
+float BezierTable::get(float x) const {
+    float u = (x - _start) * _scale;
+    const auto last = static_cast<float>(_last + 1);
+    u = u > 0.0f ? u : 0.0f;    // 同时处理 NaN
+    u = u < last ? u : last;
+    const size_t index = std::min(static_cast<size_t>(u), _last);
+    const float f = u - static_cast<float>(index);
+    if (_interpolation == Interpolation::Linear) {
+        const float a = _values[index];
+        return a + f * (_values[index + 1] - a);
+    }
+    const float* segment = _values.data() + index * 4;
+    return ((segment[3] * f + segment[2]) * f + segment[1]) * f + segment[0];
+}
+
+void BezierTable::get(const float *x, float *out, size_t count) const {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = get(x[i]);
+    }
+}
+
+float BezierTable::operator[](float x) const {
+    return get(x);
+}
+
+size_t BezierTable::size() const {
+    return _last + 2;
+}
+
+BezierTable::Interpolation BezierTable::interpolation() const {
+    return _interpolation;
+}
@@ -1,48 +1,71 @@
 #include "Transform.h"
 
-#include <glm/ext/matrix_transform.hpp>
+#include <utility>
+
 #include <glm/gtc/quaternion.hpp>
 
-glm::mat4 Transform::getMatrix() const {
-    if (!_isDirty) {
-        return _cacheMatrix;
+Transform::Transform(): Transform(TransformPool::global()) {}
+
+Transform::Transform(TransformPool &pool): _pool(&pool), _handle(pool.allocate()) {}
+
+Transform::~Transform() {
+    if (_handle != TransformPool::invalidHandle) {
+        _pool->release(slot());
     }
-    _isDirty = false;
-    _cacheMatrix = glm::mat4(1.0f);
-    _cacheMatrix = glm::translate(_cacheMatrix, _position - _origin);
-    _cacheMatrix *= glm::mat4_cast(_rotation);
-    _cacheMatrix = glm::scale(_cacheMatrix, _scale);
-    _cacheMatrix = glm::translate(_cacheMatrix, _origin);
-
-    if (_isInverse) {
-        _cacheMatrix = glm::inverse(_cacheMatrix);
+}
+
+Transform::Transform(const Transform &other): _pool(other._pool),
+    _handle(other._handle == TransformPool::invalidHandle ? TransformPool::invalidHandle : other._pool->clone(other._handle)) {}
+
+Transform &Transform::operator=(const Transform &other) {
+    if (this == &other) return *this;
+    // 源尚未持有槽位时即为单位变换, 目标同样退回未持有状态
+    if (other._handle == TransformPool::invalidHandle || _pool != other._pool) {
+        if (_handle != TransformPool::invalidHandle) {
+            _pool->release(slot());
+        }
+        _pool = other._pool;
+        _handle = other._handle == TransformPool::invalidHandle ? TransformPool::invalidHandle : other._pool->clone(other._handle);
+        return *this;
     }
-    return _cacheMatrix;
+    _pool->copy(slot(), other._handle);
+    return *this;
 }
 
-Transform &Transform::configInverse(bool isInverse) {
-    if (_isInverse != isInverse) {
-        _isInverse = isInverse;
-        _isDirty = true;
+Transform::Transform(Transform &&other) noexcept: _pool(other._pool), _handle(std::exchange(other._handle, TransformPool::invalidHandle)) {}
+
+Transform &Transform::operator=(Transform &&other) noexcept {
+    if (this == &other) return *this;
+    // 与移动构造一致: 先归还自身槽位, 被移出的变换留在原池中
+    if (_handle != TransformPool::invalidHandle) {
+        _pool->release(slot());
     }
+    _pool = other._pool;
+    _handle = std::exchange(other._handle, TransformPool::invalidHandle);
+    return *this;
+}
+
+glm::mat4 Transform::getMatrix() const {
+    return _pool->matrix(slot());
+}
+
+Transform &Transform::configInverse(bool isInverse) {
+    _pool->setInverse(slot(), isInverse);
     return *this;
 }
 
 Transform& Transform::origin(const glm::vec3& vec) {
-    _origin = vec;
-    _isDirty = true;
+    _pool->setOrigin(slot(), vec);
     return *this;
 }
 
 Transform& Transform::translate(const glm::vec3& vec) {
-    _position += vec;
-    _isDirty = true;
+    _pool->setPosition(slot(), _pool->position(slot()) + vec);
     return *this;
 }
 
 Transform& Transform::scale(const glm::vec3& vec) {
-    _scale *= vec;
-    _isDirty = true;
+    _pool->setScale(slot(), _pool->scale(slot()) * vec);
     return *this;
 }
 
@@ -51,80 +74,79 @@ Transform& Transform::rotate(const glm::vec3& vec) {
 }
 
 Transform &Transform::rotate(const glm::quat &quat) {
-    _rotation *= quat;
-    _isDirty = true;
+    _pool->setRotation(slot(), _pool->rotation(slot()) * quat);
     return *this;
 }
 
-const glm::vec3& Transform::getOrigin() const {
-    return _origin;
+glm::vec3 Transform::getOrigin() const {
+    return _pool->origin(slot());
+}
+
+glm::vec3 Transform::getPosition() const {
+    return _pool->position(slot());
+}
+
+glm::quat Transform::getRotation() const {
+    return _pool->rotation(slot());
 }
 
-const glm::vec3 &Transform::getPosition() const {
-    return _position;
+glm::vec3 Transform::getScale() const {
+    return _pool->scale(slot());
 }
 
-const glm::quat &Transform::getRotation() const {
-    return _rotation;
+TransformPool &Transform::pool() const {
+    return *_pool;
 }
 
-const glm::vec3 &Transform::getScale() const {
-    return _scale;
+TransformPool::Handle Transform::handle() const {
+    return slot();
 }
 
 Transform &Transform::setRotate(const glm::vec3& vec) {
-    _rotation = vec3toQuat(vec);
-    _isDirty = true;
+    _pool->setRotation(slot(), vec3toQuat(vec));
     return *this;
 }
 
 Transform &Transform::setRotate(const glm::quat &quat) {
-    _rotation = quat;
-    _isDirty = true;
+    _pool->setRotation(slot(), quat);
     return *this;
 }
 
 Transform &Transform::setScale(const glm::vec3 &vec) {
-    _scale = vec;
-    _isDirty = true;
+    _pool->setScale(slot(), vec);
     return *this;
 }
 
 Transform &Transform::setTranslate(const glm::vec3 &vec) {
-    _position = vec;
-    _isDirty = true;
+    _pool->setPosition(slot(), vec);
     return *this;
 }
 
 Transform &Transform::resetOrigin() {
-    _origin = {0.0f, 0.0f, 0.0f};
-    _isDirty = true;
+    _pool->setOrigin(slot(), {0.0f, 0.0f, 0.0f});
     return *this;
 }
 
 Transform &Transform::resetTranslate() {
-    _position = {0.0f, 0.0f, 0.0f};
-    _isDirty = true;
+    _pool->setPosition(slot(), {0.0f, 0.0f, 0.0f});
     return *this;
 }
 
 
 Transform &Transform::resetRotate() {
-    _rotation = {1.0f, 0.0f, 0.0f, 0.0f};
-    _isDirty = true;
+    _pool->setRotation(slot(), {1.0f, 0.0f, 0.0f, 0.0f});
     return *this;
 }
 
 
 Transform &Transform::resetScale() {
-    _scale = {1.0f, 1.0f, 1.0f};
-    _isDirty = true;
+    _pool->setScale(slot(), {1.0f, 1.0f, 1.0f});
     return *this;
 }
 
 
 bool Transform::isDirty() const {
-    return _isDirty;
+    return _pool->isDirty(slot());
 }
 
 glm::mat4 Transform::worldMatrix(const std::vector<Transform> &transforms)  {
@@ -151,6 +173,13 @@ glm::mat4 Transform::worldMatrix(const std::vector<std::reference_wrapper<Transf
     return out;
 }
 
+TransformPool::Handle Transform::slot() const {
+    if (_handle == TransformPool::invalidHandle) {
+        _handle = _pool->allocate();
+    }
+    return _handle;
+}
+
 glm::quat Transform::vec3toQuat(const glm::vec3 &vec) {
     return glm::quat(vec);
 }
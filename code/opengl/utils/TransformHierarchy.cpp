@@ -0,0 +1,77 @@
+#include "TransformHierarchy.h"
+
+#include <GlobalLogger.hpp>
+
+namespace {
+    const glm::mat4 identity{1.0f};
+}
+
+TransformHierarchy::TransformHierarchy(TransformPool &pool): _pool(&pool) {}
+
+void TransformHierarchy::build(Node<Transform> &root) {
+    build(root, [](Node<Transform>& e) -> const Transform& { return e.get(); });
+}
+
+TransformHierarchy::Index TransformHierarchy::append(const Transform &local, Index parent) {
+    const auto index = static_cast<Index>(_locals.size());
+    if (parent != invalidIndex && parent >= index) {
+        glog.log<DefaultLevel::Warn>("层级变换的父节点须先于子节点追加, 已作为根节点处理");
+        parent = invalidIndex;
+    }
+    _locals.push_back(&local);
+    _parents.push_back(parent);
+    _handles.push_back(TransformPool::invalidHandle);
+    _versions.push_back(0);
+    _changed.push_back(0);
+    _worlds.emplace_back(1.0f);
+    _indices.insert_or_assign(&local, index);
+    return index;
+}
+
+size_t TransformHierarchy::update() {
+    _pool->update();
+    size_t count{0};
+    for (size_t i = 0; i < _locals.size(); i++) {
+        const Transform& local = *_locals[i];
+        const Index parent = _parents[i];
+        const TransformPool::Handle handle = local.handle();
+        const uint32_t version = local.pool().version(handle);
+        // 版本比对不依赖脏标记, 其他使用方先取过矩阵也不会漏掉变化
+        const bool changed = handle != _handles[i] || version != _versions[i] || (parent != invalidIndex && _changed[parent]);
+        _changed[i] = changed;
+        if (!changed) continue;
+        _handles[i] = handle;
+        _versions[i] = version;
+        _worlds[i] = parent == invalidIndex ? local.getMatrix() : _worlds[parent] * local.getMatrix();
+        count++;
+    }
+    return count;
+}
+
+const glm::mat4 &TransformHierarchy::world(Index index) const {
+    return _worlds[index];
+}
+
+const glm::mat4 &TransformHierarchy::world(const Transform &local) const {
+    const Index index = indexOf(local);
+    return index == invalidIndex ? identity : _worlds[index];
+}
+
+TransformHierarchy::Index TransformHierarchy::indexOf(const Transform &local) const {
+    const auto it = _indices.find(&local);
+    return it == _indices.end() ? invalidIndex : it->second;
+}
+
+size_t TransformHierarchy::size() const {
+    return _locals.size();
+}
+
+void TransformHierarchy::clear() {
+    _locals.clear();
+    _parents.clear();
+    _handles.clear();
+    _versions.clear();
+    _changed.clear();
+    _worlds.clear();
+    _indices.clear();
+}
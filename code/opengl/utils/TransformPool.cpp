@@ -0,0 +1,385 @@
+#include "TransformPool.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRANSFORM_POOL_SSE 1
+#endif
+
+namespace {
+#ifdef TRANSFORM_POOL_SSE
+    /**
+     * @brief 4 个变换的同一分量
+     * @details 与 float 提供相同的运算符, 使标量与批量路径共用同一份合成代码
+     */
+    struct Lanes {
+        __m128 v;
+        Lanes() = default;
+        Lanes(const float value): v(_mm_set1_ps(value)) {}
+        explicit Lanes(const __m128 value): v(value) {}
+        explicit Lanes(const float* source): v(_mm_loadu_ps(source)) {}
+    };
+
+    inline Lanes operator + (const Lanes a, const Lanes b) { return Lanes(_mm_add_ps(a.v, b.v)); }
+    inline Lanes operator - (const Lanes a, const Lanes b) { return Lanes(_mm_sub_ps(a.v, b.v)); }
+    inline Lanes operator * (const Lanes a, const Lanes b) { return Lanes(_mm_mul_ps(a.v, b.v)); }
+    inline Lanes operator / (const Lanes a, const Lanes b) { return Lanes(_mm_div_ps(a.v, b.v)); }
+#endif
+
+    /**
+     * @brief 由四元数[x, y, z, w]求旋转矩阵的各列
+     */
+    template<typename T>
+    inline void rotationColumns(const T (&r)[4], T (&out)[3][3]) {
+        const T one{1.0f}, two{2.0f};
+        const T xx = r[0] * r[0], yy = r[1] * r[1], zz = r[2] * r[2];
+        const T xy = r[0] * r[1], xz = r[0] * r[2], yz = r[1] * r[2];
+        const T wx = r[3] * r[0], wy = r[3] * r[1], wz = r[3] * r[2];
+
+        out[0][0] = one - two * (yy + zz);
+        out[0][1] = two * (xy + wz);
+        out[0][2] = two * (xz - wy);
+        out[1][0] = two * (xy - wz);
+        out[1][1] = one - two * (xx + zz);
+        out[1][2] = two * (yz + wx);
+        out[2][0] = two * (xz + wy);
+        out[2][1] = two * (yz - wx);
+        out[2][2] = one - two * (xx + yy);
+    }
+
+    /**
+     * @brief 合成 translate(p - o) * mat4_cast(r) * scale(s) * translate(o) 的前三行
+     * @details 展开为闭式: 前三列为旋转矩阵按列缩放, 第四列为 p - o + RS * o
+     * @param p 位置
+     * @param r 旋转[x, y, z, w]
+     * @param s 缩放
+     * @param o 原点
+     * @param out 输出的各列前三个分量
+     */
+    template<typename T>
+    inline void composeColumns(const T (&p)[3], const T (&r)[4], const T (&s)[3], const T (&o)[3], T (&out)[4][3]) {
+        T rotation[3][3];
+        rotationColumns(r, rotation);
+        for (size_t c = 0; c < 3; c++) {
+            for (size_t k = 0; k < 3; k++) {
+                out[c][k] = rotation[c][k] * s[c];
+            }
+        }
+        for (size_t k = 0; k < 3; k++) {
+            out[3][k] = p[k] - o[k] + out[0][k] * o[0] + out[1][k] * o[1] + out[2][k] * o[2];
+        }
+    }
+
+    /**
+     * @brief 合成上述变换的逆的前三行
+     * @details 仿射逆为 translate(-o) * scale(1 / s) * transpose(R) * translate(o - p):
+     * 前三列为 S^-1 R^T, 第四列为 -(S^-1 R^T)(p - o) - o; 缩放分量为 0 时与一般求逆一样得不到有限值
+     * @param p 位置
+     * @param r 旋转[x, y, z, w]
+     * @param s 缩放
+     * @param o 原点
+     * @param out 输出的各列前三个分量
+     */
+    template<typename T>
+    inline void composeInverseColumns(const T (&p)[3], const T (&r)[4], const T (&s)[3], const T (&o)[3], T (&out)[4][3]) {
+        T rotation[3][3];
+        rotationColumns(r, rotation);
+        const T one{1.0f}, zero{0.0f};
+        const T inverseScale[3]{one / s[0], one / s[1], one / s[2]};
+        for (size_t c = 0; c < 3; c++) {
+            for (size_t k = 0; k < 3; k++) {
+                out[c][k] = rotation[k][c] * inverseScale[k];
+            }
+        }
+        const T offset[3]{p[0] - o[0], p[1] - o[1], p[2] - o[2]};
+        for (size_t k = 0; k < 3; k++) {
+            out[3][k] = zero - (out[0][k] * offset[0] + out[1][k] * offset[1] + out[2][k] * offset[2]) - o[k];
+        }
+    }
+
+    /**
+     * @brief 写出单个矩阵
+     * @details 4x4 按列主序, 3x4 按行主序[省去恒为 0, 0, 0, 1 的末行]
+     */
+    constexpr float identityColumns[4][3]{{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+
+    inline void storeMatrix(float* target, const float (&columns)[4][3], const TransformPool::Storage storage) {
+        if (storage == TransformPool::Storage::Matrix4x4) {
+            for (size_t c = 0; c < 4; c++) {
+                target[c * 4] = columns[c][0];
+                target[c * 4 + 1] = columns[c][1];
+                target[c * 4 + 2] = columns[c][2];
+                target[c * 4 + 3] = c == 3 ? 1.0f : 0.0f;
+            }
+            return;
+        }
+        for (size_t row = 0; row < 3; row++) {
+            for (size_t c = 0; c < 4; c++) {
+                target[row * 4 + c] = columns[c][row];
+            }
+        }
+    }
+}
+
+TransformPool::TransformPool(Storage storage): _storage(storage), _stride(storage == Storage::Matrix4x4 ? 16 : 12) {}
+
+TransformPool &TransformPool::global() {
+    static TransformPool pool{};
+    return pool;
+}
+
+TransformPool::Handle TransformPool::allocate() {
+    if (_free.empty()) {
+        grow();
+    }
+    const Handle handle = _free.back();
+    _free.pop_back();
+    _px[handle] = _py[handle] = _pz[handle] = 0.0f;
+    _rx[handle] = _ry[handle] = _rz[handle] = 0.0f;
+    _rw[handle] = 1.0f;
+    _sx[handle] = _sy[handle] = _sz[handle] = 1.0f;
+    _ox[handle] = _oy[handle] = _oz[handle] = 0.0f;
+    _inverse[handle] = 0;
+    _versions[handle]++;
+    storeMatrix(_matrices.data() + handle * _stride, identityColumns, _storage);
+    return handle;
+}
+
+TransformPool::Handle TransformPool::clone(Handle source) {
+    const Handle handle = allocate();
+    copy(handle, source);
+    return handle;
+}
+
+void TransformPool::copy(Handle target, Handle source) {
+    if (target == source) return;
+    for (auto* e : {&_px, &_py, &_pz, &_rx, &_ry, &_rz, &_rw, &_sx, &_sy, &_sz, &_ox, &_oy, &_oz}) {
+        (*e)[target] = (*e)[source];
+    }
+    _inverse[target] = _inverse[source];
+    _versions[target]++;
+    std::copy_n(_matrices.data() + source * _stride, _stride, _matrices.data() + target * _stride);
+    if (_dirty[source]) {
+        markDirty(target);
+    } else if (_dirty[target]) {
+        _dirty[target] = 0;
+        _dirtyCount--;
+    }
+}
+
+void TransformPool::release(Handle handle) {
+    if (_dirty[handle]) {
+        _dirty[handle] = 0;
+        _dirtyCount--;
+    }
+    _free.push_back(handle);
+}
+
+void TransformPool::setPosition(Handle handle, const glm::vec3 &vec) {
+    _px[handle] = vec.x;
+    _py[handle] = vec.y;
+    _pz[handle] = vec.z;
+    markDirty(handle);
+}
+
+void TransformPool::setRotation(Handle handle, const glm::quat &quat) {
+    _rx[handle] = quat.x;
+    _ry[handle] = quat.y;
+    _rz[handle] = quat.z;
+    _rw[handle] = quat.w;
+    markDirty(handle);
+}
+
+void TransformPool::setScale(Handle handle, const glm::vec3 &vec) {
+    _sx[handle] = vec.x;
+    _sy[handle] = vec.y;
+    _sz[handle] = vec.z;
+    markDirty(handle);
+}
+
+void TransformPool::setOrigin(Handle handle, const glm::vec3 &vec) {
+    _ox[handle] = vec.x;
+    _oy[handle] = vec.y;
+    _oz[handle] = vec.z;
+    markDirty(handle);
+}
+
+void TransformPool::setInverse(Handle handle, bool isInverse) {
+    if (static_cast<bool>(_inverse[handle]) == isInverse) return;
+    _inverse[handle] = isInverse;
+    markDirty(handle);
+}
+
+glm::vec3 TransformPool::position(Handle handle) const {
+    return {_px[handle], _py[handle], _pz[handle]};
+}
+
+glm::quat TransformPool::rotation(Handle handle) const {
+    return {_rw[handle], _rx[handle], _ry[handle], _rz[handle]};
+}
+
+glm::vec3 TransformPool::scale(Handle handle) const {
+    return {_sx[handle], _sy[handle], _sz[handle]};
+}
+
+glm::vec3 TransformPool::origin(Handle handle) const {
+    return {_ox[handle], _oy[handle], _oz[handle]};
+}
+
+bool TransformPool::inverse(Handle handle) const {
+    return _inverse[handle];
+}
+
+bool TransformPool::isDirty(Handle handle) const {
+    return _dirty[handle];
+}
+
+uint32_t TransformPool::version(Handle handle) const {
+    return _versions[handle];
+}
+
+glm::mat4 TransformPool::matrix(Handle handle) {
+    if (_dirty[handle]) {
+        compose(handle);
+        _dirty[handle] = 0;
+        _dirtyCount--;
+    }
+    const float* source = _matrices.data() + handle * _stride;
+    glm::mat4 out{1.0f};
+    for (size_t c = 0; c < 4; c++) {
+        for (size_t k = 0; k < 3; k++) {
+            out[c][k] = _storage == Storage::Matrix4x4 ? source[c * 4 + k] : source[k * 4 + c];
+        }
+    }
+    return out;
+}
+
+const float *TransformPool::rows(Handle handle) {
+    if (_dirty[handle]) {
+        compose(handle);
+        _dirty[handle] = 0;
+        _dirtyCount--;
+    }
+    return _matrices.data() + handle * _stride;
+}
+
+void TransformPool::update() {
+    if (_dirtyCount == 0) return;
+    for (size_t first = 0; first < _dirty.size(); first += batchWidth) {
+        uint8_t* mask = _dirty.data() + first;
+        if ((mask[0] | mask[1] | mask[2] | mask[3]) == 0) continue;
+        composeBatch(first, mask);
+        std::fill_n(mask, batchWidth, uint8_t{0});
+    }
+    _dirtyCount = 0;
+}
+
+size_t TransformPool::size() const {
+    return _dirty.size() - _free.size();
+}
+
+size_t TransformPool::capacity() const {
+    return _dirty.size();
+}
+
+TransformPool::Storage TransformPool::storage() const {
+    return _storage;
+}
+
+size_t TransformPool::stride() const {
+    return _stride;
+}
+
+const float *TransformPool::data() const {
+    return _matrices.data();
+}
+
+size_t TransformPool::dirtyCount() const {
+    return _dirtyCount;
+}
+
+void TransformPool::markDirty(Handle handle) {
+    _versions[handle]++;
+    if (!_dirty[handle]) {
+        _dirty[handle] = 1;
+        _dirtyCount++;
+    }
+}
+
+void TransformPool::grow() {
+    const size_t size = _dirty.size() + batchWidth;
+    for (auto* e : {&_px, &_py, &_pz, &_rx, &_ry, &_rz, &_ox, &_oy, &_oz}) {
+        e->resize(size, 0.0f);
+    }
+    for (auto* e : {&_rw, &_sx, &_sy, &_sz}) {
+        e->resize(size, 1.0f);
+    }
+    _dirty.resize(size, 0);
+    _inverse.resize(size, 0);
+    _versions.resize(size, 0);
+    _matrices.resize(size * _stride, 0.0f);
+    for (size_t i = size - batchWidth; i < size; i++) {
+        storeMatrix(_matrices.data() + i * _stride, identityColumns, _storage);
+    }
+    // 逆序压入, 使组内低位槽位先被分配
+    for (size_t i = size; i != size - batchWidth; i--) {
+        _free.push_back(static_cast<Handle>(i - 1));
+    }
+}
+
+void TransformPool::compose(Handle handle) {
+    const float p[3]{_px[handle], _py[handle], _pz[handle]};
+    const float r[4]{_rx[handle], _ry[handle], _rz[handle], _rw[handle]};
+    const float s[3]{_sx[handle], _sy[handle], _sz[handle]};
+    const float o[3]{_ox[handle], _oy[handle], _oz[handle]};
+    float out[4][3];
+    if (_inverse[handle]) {
+        composeInverseColumns(p, r, s, o, out);
+    } else {
+        composeColumns(p, r, s, o, out);
+    }
+    storeMatrix(_matrices.data() + handle * _stride, out, _storage);
+}
+
+void TransformPool::composeBatch(size_t first, const uint8_t *mask) {
+#ifdef TRANSFORM_POOL_SSE
+    const Lanes p[3]{Lanes(&_px[first]), Lanes(&_py[first]), Lanes(&_pz[first])};
+    const Lanes r[4]{Lanes(&_rx[first]), Lanes(&_ry[first]), Lanes(&_rz[first]), Lanes(&_rw[first])};
+    const Lanes s[3]{Lanes(&_sx[first]), Lanes(&_sy[first]), Lanes(&_sz[first])};
+    const Lanes o[3]{Lanes(&_ox[first]), Lanes(&_oy[first]), Lanes(&_oz[first])};
+    const uint8_t* inverse = _inverse.data() + first;
+
+    // 4x4 按列转置为各变换的矩阵列, 3x4 按行转置为各变换的矩阵行
+    auto store = [&](const Lanes (&out)[4][3], const bool inverted) {
+        for (size_t group = 0; group < (_storage == Storage::Matrix4x4 ? 4 : 3); group++) {
+            __m128 x, y, z, w;
+            if (_storage == Storage::Matrix4x4) {
+                x = out[group][0].v, y = out[group][1].v, z = out[group][2].v, w = _mm_set1_ps(group == 3 ? 1.0f : 0.0f);
+            } else {
+                x = out[0][group].v, y = out[1][group].v, z = out[2][group].v, w = out[3][group].v;
+            }
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            const __m128 lanes[batchWidth]{x, y, z, w};
+            for (size_t i = 0; i < batchWidth; i++) {
+                if (mask[i] && static_cast<bool>(inverse[i]) == inverted) {
+                    _mm_storeu_ps(_matrices.data() + (first + i) * _stride + group * 4, lanes[i]);
+                }
+            }
+        }
+    };
+    Lanes out[4][3];
+    composeColumns(p, r, s, o, out);
+    store(out, false);
+    // 逆变换较少, 组内存在时才再合成一遍
+    if ((mask[0] & inverse[0]) | (mask[1] & inverse[1]) | (mask[2] & inverse[2]) | (mask[3] & inverse[3])) {
+        composeInverseColumns(p, r, s, o, out);
+        store(out, true);
+    }
+#else
+    for (size_t i = 0; i < batchWidth; i++) {
+        if (mask[i]) {
+            compose(static_cast<Handle>(first + i));
+        }
+    }
+#endif
+}
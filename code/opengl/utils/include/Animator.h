@@ -0,0 +1,202 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/detail/type_quat.hpp>
+
+#include "Bezier.h"
+#include "BezierTable.h"
+#include "Transform.h"
+
+/**
+ * @brief 属性动画
+ * @details 轨道驱动一个 Transform 分量或一个 float, 关键帧按轨道连续存放在共享数组中;
+ * update 顺序扫描一遍活动轨道: 推进时钟, 沿缓存的区间游标定位关键帧, 查缓动表后插值并直接写回目标;
+ * 时间只由 update 的参数推进, 不依赖窗口或上下文, 可在无界面环境下驱动; 非线程安全
+ */
+class Animator {
+    public:
+        using Track = uint32_t;
+        static constexpr Track invalidTrack{~0u};
+        using Easing = uint32_t;
+        static constexpr Easing linear{~0u};
+
+        /**
+         * @brief 轨道驱动的分量
+         */
+        enum class Channel : uint8_t {
+            Position,
+            Rotation,   // 四元数, 关键帧之间归一化线性插值
+            Scale,
+            Origin,
+            Value       // 任意 float
+        };
+
+        /**
+         * @brief 播放方式
+         */
+        enum class Playback : uint8_t {
+            Once,       // 播放到末帧后停止
+            Loop,
+            PingPong
+        };
+
+        class Builder {
+            public:
+                /**
+                 * @brief 变换轨道构建者构造
+                 * @details 目标须在轨道存续期间保持地址不变
+                 * @param animator 动画
+                 * @param target 目标变换
+                 * @param channel 驱动的分量[不可为 Value]
+                 */
+                Builder(Animator& animator, Transform& target, Channel channel);
+
+                /**
+                 * @brief 数值轨道构建者构造
+                 * @details 目标须在轨道存续期间保持地址不变
+                 * @param animator 动画
+                 * @param target 目标数值
+                 */
+                Builder(Animator& animator, float& target);
+                ~Builder() = default;
+
+                /**
+                 * @brief 添加关键帧
+                 * @details 时间须严格递增; easing 作用于本帧到下一帧的区间
+                 * @param time 时间[秒]
+                 * @param value 值
+                 * @param easing 缓动
+                 * @return 构建者引用
+                 */
+                Builder& key(float time, const glm::vec3& value, Easing easing = linear);
+                Builder& key(float time, const glm::quat& value, Easing easing = linear);
+                Builder& key(float time, float value, Easing easing = linear);
+
+                Builder& playback(Playback mode);
+
+                /**
+                 * @brief 延迟开始
+                 * @details 延迟期间不写目标
+                 * @param seconds 秒
+                 * @return 构建者引用
+                 */
+                Builder& delay(float seconds);
+
+                Builder& speed(float factor);
+
+                /**
+                 * @brief 提交轨道并开始播放
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @return 轨道[没有关键帧时为 invalidTrack]
+                 */
+                Track build();
+
+            private:
+                Animator* _animator;
+                Channel _channel;
+                void* _target;
+                Playback _playback{Playback::Once};
+                float _delay{0.0f};
+                float _speed{1.0f};
+                std::vector<float> _times;
+                std::vector<float> _values;
+                std::vector<Easing> _easings;
+
+                bool append(float time, Easing easing, bool matched);
+        };
+
+        Animator() = default;
+        ~Animator() = default;
+
+        Animator(const Animator& other) = delete;
+        Animator& operator = (const Animator& other) = delete;
+
+        /**
+         * @brief 注册缓动曲线
+         * @details 曲线预先采样为查找表, 采样时不再求逆
+         * @param curve 曲线[x 须单调]
+         * @param size 采样点数
+         * @param interpolation 插值方式
+         * @return 缓动
+         */
+        Easing addEasing(const Bezier& curve, size_t size = 256, BezierTable::Interpolation interpolation = BezierTable::Interpolation::Cubic);
+
+        /**
+         * @brief 推进并采样全部活动轨道
+         * @details 播放完毕的 Once 轨道写入末帧后停止
+         * @param delta 经过的时间[秒]
+         * @return 写回目标的轨道数量
+         */
+        size_t update(float delta);
+
+        /**
+         * @brief 继续播放
+         * @details 已播放完毕的 Once 轨道需先 seek
+         * @param track 轨道
+         */
+        void play(Track track);
+
+        void stop(Track track);
+
+        /**
+         * @brief 设置轨道时钟
+         * @details 他似乎不需要详细注释[划掉]
+         * @param track 轨道
+         * @param time 距首帧的时间[秒, 负值为剩余延迟]
+         */
+        void seek(Track track, float time);
+
+        [[nodiscard]] bool playing(Track track) const;
+
+        /**
+         * @brief 轨道数量
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 数量
+         */
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * @brief 活动轨道数量
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 数量
+         */
+        [[nodiscard]] size_t activeCount() const;
+
+        /**
+         * @brief 移除全部轨道
+         * @details 已注册的缓动保留
+         */
+        void clear();
+
+    private:
+        static constexpr uint32_t inactive{~0u};
+        static constexpr size_t valueStride{4};    // 每个关键帧的值按 4 个 float 存放
+
+        std::vector<BezierTable> _tables;
+        // 关键帧
+        std::vector<float> _keyTimes;
+        std::vector<float> _keyValues;
+        std::vector<Easing> _keyEasings;
+        // 轨道
+        std::vector<uint32_t> _keyFirst, _keyCount;
+        std::vector<Channel> _channels;
+        std::vector<Playback> _playbacks;
+        std::vector<void*> _targets;
+        std::vector<float> _clocks, _speeds, _durations;
+        std::vector<uint32_t> _cursors;     // 上次所在区间
+        std::vector<uint32_t> _slots;       // 在活动列表中的位置
+        std::vector<Track> _active;
+
+        /**
+         * @brief 采样单个轨道并写回目标
+         * @details 他似乎不需要详细注释[划掉]
+         * @param track 轨道
+         * @param local 距首帧的时间
+         */
+        void sample(Track track, float local);
+
+        void activate(Track track);
+        void deactivate(Track track);
+};
@@ -1,8 +1,11 @@
 #pragma once
+#include <cstddef>
+
 #include <glm/glm.hpp>
 
 /**
  * @brief 三阶贝塞尔曲线封装
+ * @details 单点接口以 double 计算; 批量接口以 float 按幂基展开, 4 个自变量一组用 SSE 计算
  */
 class Bezier {
     public:
@@ -80,6 +83,44 @@ class Bezier {
          */
         [[nodiscard]] double inverse_y(double t, size_t accuracy = 3) const;
 
+        /**
+         * @brief 批量计算贝塞尔曲线函数[x]
+         * @details 自变量超出 [0, 1] 时取端点
+         * @param t 自变量
+         * @param out 函数值[可与 t 相同]
+         * @param count 数量
+         */
+        void x(const float* t, float* out, size_t count) const;
+
+        /**
+         * @brief 批量计算贝塞尔曲线函数[y]
+         * @details 他似乎不需要详细注释[划掉]
+         * @param t 自变量
+         * @param out 函数值[可与 t 相同]
+         * @param count 数量
+         */
+        void y(const float* t, float* out, size_t count) const;
+
+        /**
+         * @brief 批量逆贝塞尔曲线函数[x]
+         * @details 与单点版本相同的二分加牛顿迭代, 各分支以掩码选择, 一组 4 个同时迭代
+         * @param t 函数值
+         * @param out 自变量[可与 t 相同]
+         * @param count 数量
+         * @param accuracy 精度
+         */
+        void inverse_x(const float* t, float* out, size_t count, size_t accuracy = 3) const;
+
+        /**
+         * @brief 批量逆贝塞尔曲线函数[y]
+         * @details 他似乎不需要详细注释[划掉]
+         * @param t 函数值
+         * @param out 自变量[可与 t 相同]
+         * @param count 数量
+         * @param accuracy 精度
+         */
+        void inverse_y(const float* t, float* out, size_t count, size_t accuracy = 3) const;
+
         [[nodiscard]] glm::vec2 get(double t) const;
 
         glm::vec2 operator [] (double t) const;
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "Bezier.h"
+
+/**
+ * @brief 缓动查找表
+ * @details 在 x 分量上等距采样 y = f(x)[x 须单调], 查询时按下标直接定位区间再插值, 不再求逆;
+ * 三次插值使用单调三次 Hermite[Fritsch-Carlson], 样本单调的区间内不会过冲
+ */
+class BezierTable {
+    public:
+        /**
+         * @brief 插值方式
+         */
+        enum class Interpolation {
+            Linear,
+            Cubic
+        };
+
+        /**
+         * @brief 由曲线构建查找表
+         * @details 采样点的自变量以 double 二分求得, 构建开销只在构造时
+         * @param curve 曲线
+         * @param size 采样点数[至少 2]
+         * @param interpolation 插值方式
+         */
+        explicit BezierTable(const Bezier& curve, size_t size = 256, Interpolation interpolation = Interpolation::Linear);
+        ~BezierTable() = default;
+
+        BezierTable(const BezierTable& other) = default;
+        BezierTable& operator = (const BezierTable& other) = default;
+        BezierTable(BezierTable&& other) noexcept = default;
+        BezierTable& operator = (BezierTable&& other) noexcept = default;
+
+        /**
+         * @brief 查询缓动值
+         * @details x 超出曲线 x 范围时取端点
+         * @param x 自变量[通常为进度]
+         * @return 函数值
+         */
+        [[nodiscard]] float get(float x) const;
+
+        /**
+         * @brief 批量查询缓动值
+         * @details 他似乎不需要详细注释[划掉]
+         * @param x 自变量
+         * @param out 函数值[可与 x 相同]
+         * @param count 数量
+         */
+        void get(const float* x, float* out, size_t count) const;
+
+        float operator [] (float x) const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] Interpolation interpolation() const;
+
+    private:
+        Interpolation _interpolation;
+        float _start{};
+        float _scale{};   // 自变量到采样下标的比例
+        size_t _last{};   // 最后一个区间的下标
+        // 线性时为各采样值, 三次时为各区间的 4 个幂基系数
+        std::vector<float> _values;
+};
@@ -53,7 +53,7 @@ class ModelVertexMeta: public RAIIWrapper<VectorStruct<BufferObject, BufferObjec
             if (!vertices.rawIndices().empty()) {
 
             }
-            auto& va = vertices.ExpandIndices();
+            auto& va = vertices.WeldIndices();
             auto& ea = vertices.bufferOfIndices();
         }
         ~ModelVertexMeta() override {
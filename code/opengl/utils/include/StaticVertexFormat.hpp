@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "VertexInterleave.hpp"
+#include "VertexLayout.hpp"
+
+/**
+ * @brief 编译期顶点格式
+ * @details 以属性类型列表描述顶点格式, 步长/偏移/交错循环均在编译期确定, float 3 + 2 + 3 格式在展开的循环内使用 SSE 拼接;
+ * 通过 Format::builder() 或 VertexLayout::bindFormat 与运行时布局互通, 非常规格式仍走运行时路径
+ */
+namespace vertex_format {
+    /**
+     * @brief 可作为模板实参的定长字符串
+     * @tparam N 长度[含结尾空字符]
+     */
+    template<size_t N>
+    struct FixedString {
+        char value[N]{};
+
+        constexpr FixedString(const char (&str)[N]) {
+            std::copy_n(str, N, value);
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const {
+            return {value, N - 1};
+        }
+    };
+
+    /**
+     * @brief 顶点属性
+     * @tparam Identifier 元素标识符
+     * @tparam Length 元素长度
+     */
+    template<FixedString Identifier, size_t Length>
+    struct Attribute {
+        static_assert(Length > 0, "错误: 顶点属性长度[ Length ]不能为零");
+        static constexpr std::string_view identifier = Identifier.view();
+        static constexpr size_t length = Length;
+    };
+
+    /**
+     * @brief 编译期顶点格式
+     * @tparam T 缓冲区类型
+     * @tparam Attributes 顶点属性[location顺序]
+     */
+    template<typename T, typename... Attributes>
+    struct Format {
+        static_assert(sizeof...(Attributes) > 0, "错误: 顶点格式至少需要一个属性");
+
+        using ValueType = T;
+        static constexpr size_t count = sizeof...(Attributes);
+        static constexpr size_t stride = (Attributes::length + ...);
+        static constexpr std::array<size_t, count> lengths{Attributes::length...};
+        static constexpr std::array<std::string_view, count> identifiers{Attributes::identifier...};
+        static constexpr std::array<size_t, count> offsets = [] {
+            std::array<size_t, count> out{};
+            size_t origin{0};
+            for (size_t i = 0; i < count; i++) {
+                out[i] = origin;
+                origin += lengths[i];
+            }
+            return out;
+        }();
+
+        /**
+         * @brief 获取预先声明全部元素并绑定此格式的构建者
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 构建者
+         */
+        static typename VertexLayout<T>::Builder builder() {
+            auto out = VertexLayout<T>::builder();
+            (out.appendElement(std::string(Attributes::identifier), Attributes::length), ...);
+            out.template format<Format>();
+            return out;
+        }
+
+        /**
+         * @brief 运行时布局是否与此格式一致
+         * @details 逐个比对元素标识符与长度
+         * @param layout 缓冲区组装布局
+         * @return 他似乎不需要注释[划掉]
+         */
+        static bool matches(const VertexLayout<T>& layout) {
+            const auto& elements = layout.elements();
+            if (elements.size() != count) return false;
+            for (size_t i = 0; i < count; i++) {
+                if (elements[i].identifier != identifiers[i] || elements[i].length != lengths[i]) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief 按顺序交错[编译期展开]
+         * @details 签名与 interleave::sequential 一致, 列长度与步长已由格式确定
+         */
+        static void sequential(const std::vector<interleave::Column<T>>& columns, const size_t vertexCount, size_t, T* out) {
+            const auto src = sources(columns);
+            size_t v{0};
+#ifdef VERTEX_INTERLEAVE_SSE
+            if constexpr (isPosUvNormal()) {
+                // 最后一个顶点的 4 float 读取会越界, 交给展开路径
+                for (; v + 1 < vertexCount; v++) {
+                    interleave::vertex323(src[0] + v * 3, src[1] + v * 2, src[2] + v * 3, out + v * stride);
+                }
+            }
+#endif
+            for (; v < vertexCount; v++) {
+                copyVertex(src, v, out + v * stride, std::make_index_sequence<count>{});
+            }
+        }
+
+        /**
+         * @brief 按索引交错[编译期展开]
+         * @details 签名与 interleave::gather 一致, 列长度与步长已由格式确定
+         */
+        static void gather(const std::vector<interleave::Column<T>>& columns, const unsigned int* indices, const size_t cornerCount, size_t, T* out) {
+            const auto src = sources(columns);
+#ifdef VERTEX_INTERLEAVE_SSE
+            if constexpr (isPosUvNormal()) {
+                // 索引小于 safe 的顶点可安全多读 1 个 float
+                const size_t pSafe = columns[0].count >= 4 ? (columns[0].count - 4) / 3 + 1 : 0;
+                const size_t nSafe = columns[2].count >= 4 ? (columns[2].count - 4) / 3 + 1 : 0;
+                for (size_t c = 0; c < cornerCount; c++) {
+                    const unsigned int* corner = indices + c * count;
+                    if (corner[0] < pSafe && corner[2] < nSafe) {
+                        interleave::vertex323(src[0] + corner[0] * 3, src[1] + corner[1] * 2, src[2] + corner[2] * 3, out + c * stride);
+                    } else {
+                        copyCorner(src, corner, out + c * stride, std::make_index_sequence<count>{});
+                    }
+                }
+                return;
+            }
+#endif
+            for (size_t c = 0; c < cornerCount; c++) {
+                copyCorner(src, indices + c * count, out + c * stride, std::make_index_sequence<count>{});
+            }
+        }
+
+    private:
+        static constexpr bool isPosUvNormal() {
+            return std::is_same_v<T, float> && count == 3 && lengths[0] == 3 && lengths[1] == 2 && lengths[2] == 3;
+        }
+
+        static std::array<const T*, count> sources(const std::vector<interleave::Column<T>>& columns) {
+            std::array<const T*, count> out{};
+            for (size_t i = 0; i < count; i++) {
+                out[i] = columns[i].source;
+            }
+            return out;
+        }
+
+        template<size_t Length>
+        static void copyFixed(const T* src, T* out) {
+            [&]<size_t... K>(std::index_sequence<K...>) {
+                ((out[K] = src[K]), ...);
+            }(std::make_index_sequence<Length>{});
+        }
+
+        template<size_t... I>
+        static void copyVertex(const std::array<const T*, count>& src, const size_t v, T* target, std::index_sequence<I...>) {
+            (copyFixed<lengths[I]>(src[I] + v * lengths[I], target + offsets[I]), ...);
+        }
+
+        template<size_t... I>
+        static void copyCorner(const std::array<const T*, count>& src, const unsigned int* corner, T* target, std::index_sequence<I...>) {
+            (copyFixed<lengths[I]>(src[I] + corner[I] * lengths[I], target + offsets[I]), ...);
+        }
+    };
+
+    /**
+     * @brief obj模型解析产出的 位置 + 纹理坐标 + 法线 格式
+     */
+    using PositionTexCoordNormal = Format<float,
+        Attribute<"vertices", 3>,
+        Attribute<"texCoord", 2>,
+        Attribute<"normal", 3>>;
+}
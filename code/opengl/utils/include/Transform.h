@@ -2,10 +2,23 @@
 #include <glm/glm.hpp>
 #include <glm/detail/type_quat.hpp>
 
+#include "TransformPool.h"
+
+/**
+ * @brief 变换
+ * @details 变换池中槽位的句柄, 保持值语义: 复制时在同一池中分配新槽位, 移动时转移槽位;
+ * 被移出的变换仍属于原池, 表现为单位变换, 再次使用时才在原池中分配新的单位槽位
+ */
 class Transform {
     public:
-        Transform() = default;
-        ~Transform() = default;
+        Transform();
+        explicit Transform(TransformPool& pool);
+        ~Transform();
+
+        Transform(const Transform& other);
+        Transform& operator = (const Transform& other);
+        Transform(Transform&& other) noexcept;
+        Transform& operator = (Transform&& other) noexcept;
 
         Transform& configInverse(bool _isInverse = true);
 
@@ -25,10 +38,13 @@ class Transform {
         Transform& resetScale();
         Transform& resetRotate();
 
-        const glm::vec3 &getOrigin() const;
-        const glm::vec3 &getPosition() const;
-        const glm::quat &getRotation() const;
-        const glm::vec3 &getScale() const;
+        [[nodiscard]] glm::vec3 getOrigin() const;
+        [[nodiscard]] glm::vec3 getPosition() const;
+        [[nodiscard]] glm::quat getRotation() const;
+        [[nodiscard]] glm::vec3 getScale() const;
+
+        [[nodiscard]] TransformPool& pool() const;
+        [[nodiscard]] TransformPool::Handle handle() const;
 
         static glm::mat4 worldMatrix(const std::vector<Transform>& transforms);
         static glm::mat4 worldMatrix(const std::vector<std::reference_wrapper<const Transform>> &transforms);
@@ -42,13 +58,10 @@ class Transform {
             return getMatrix();
         }
     private:
-        bool _isInverse{false};
-        glm::vec3 _position{0.0};
-        glm::quat _rotation{1.0, 0.0, 0.0, 0.0};
-        glm::vec3 _scale{1.0, 1.0, 1.0};
-        glm::vec3 _origin{0.0};
-        mutable glm::mat4 _cacheMatrix{1.0f};
-        mutable bool _isDirty{true};
+        TransformPool* _pool{nullptr};
+        mutable TransformPool::Handle _handle{TransformPool::invalidHandle};   // 被移出后为 invalidHandle, 由 slot 按需分配
+
+        TransformPool::Handle slot() const;
 
         static inline glm::quat vec3toQuat(const glm::vec3& vec);
 };
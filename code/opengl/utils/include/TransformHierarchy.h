@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Node.hpp>
+
+#include "Transform.h"
+
+/**
+ * @brief 层级变换
+ * @details 节点按父先于子的顺序平铺存放, 缓存每个节点的世界矩阵;
+ * update 顺序扫描一遍, 只有局部变换版本变化的节点及其子树会重新相乘, 其余节点沿用缓存;
+ * 非根节点的世界矩阵与 Transform::worldMatrix(node.tracebackToRoot(true)) 一致[追溯链包含根节点],
+ * 根节点的世界矩阵为其自身的局部矩阵, 而根节点的追溯链为空
+ */
+class TransformHierarchy {
+    public:
+        using Index = uint32_t;
+        static constexpr Index invalidIndex{~0u};
+
+        explicit TransformHierarchy(TransformPool& pool = TransformPool::global());
+        ~TransformHierarchy() = default;
+
+        /**
+         * @brief 由节点树构建
+         * @details 节点树的列表按创建顺序存放, 子节点总在父节点之后, 可直接作为平铺顺序;
+         * 节点须在层级存续期间保持地址不变, 树结构变化后需重新构建
+         * @param root 根节点
+         * @param access 由节点取局部变换
+         */
+        template<typename Tree, typename Access>
+        void build(Tree& root, Access&& access) {
+            clear();
+            std::unordered_map<const Tree*, Index> indices{};
+            indices.reserve(root.list().size() + 1);
+            indices.emplace(&root, append(access(root), invalidIndex));
+            for (auto& e : root.list()) {
+                const auto parent = indices.find(&e.parent());
+                indices.emplace(&e, append(access(e), parent == indices.end() ? invalidIndex : parent->second));
+            }
+        }
+
+        /**
+         * @brief 由变换节点树构建
+         * @details 他似乎不需要详细注释[划掉]
+         * @param root 根节点
+         */
+        void build(Node<Transform>& root);
+
+        /**
+         * @brief 追加节点
+         * @details 父节点须已追加, 否则作为根节点处理
+         * @param local 局部变换
+         * @param parent 父节点序号
+         * @return 节点序号
+         */
+        Index append(const Transform& local, Index parent = invalidIndex);
+
+        /**
+         * @brief 更新世界矩阵
+         * @details 先批量合成变换池中的脏矩阵, 再按平铺顺序传播
+         * @return 重新计算的世界矩阵数量
+         */
+        size_t update();
+
+        /**
+         * @brief 取世界矩阵
+         * @details 他似乎不需要详细注释[划掉]
+         * @param index 节点序号
+         * @return 上次 update 时的世界矩阵
+         */
+        [[nodiscard]] const glm::mat4& world(Index index) const;
+
+        /**
+         * @brief 通过局部变换取世界矩阵
+         * @details 他似乎不需要详细注释[划掉]
+         * @param local 局部变换
+         * @return 上次 update 时的世界矩阵[未收录时为单位矩阵]
+         */
+        [[nodiscard]] const glm::mat4& world(const Transform& local) const;
+
+        [[nodiscard]] Index indexOf(const Transform& local) const;
+
+        [[nodiscard]] size_t size() const;
+
+        void clear();
+
+    private:
+        TransformPool* _pool;
+        std::vector<const Transform*> _locals;
+        std::vector<Index> _parents;
+        std::vector<TransformPool::Handle> _handles;    // 上次计算时的句柄与版本
+        std::vector<uint32_t> _versions;
+        std::vector<uint8_t> _changed;
+        std::vector<glm::mat4> _worlds;
+        std::unordered_map<const Transform*, Index> _indices;
+};
@@ -0,0 +1,190 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/detail/type_quat.hpp>
+
+/**
+ * @brief 变换池
+ * @details 位置/旋转/缩放/原点按分量以结构数组[SoA]存放, 槽位按 batchWidth 个一组分配;
+ * update 以组为单位用 SSE 一次合成 4 个矩阵, 只写回脏槽位; 逆变换按仿射结构解析求逆;
+ * 矩阵可选以 3x4 行主序存放[省去恒定的末行], 缓存与上传量减少 25%; 非线程安全
+ */
+class TransformPool {
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle invalidHandle{~0u};
+        static constexpr size_t batchWidth{4};
+
+        /**
+         * @brief 矩阵存放格式
+         */
+        enum class Storage {
+            Matrix4x4,  // 列主序 4x4, 与 glm::mat4 内存布局一致
+            Matrix3x4   // 行主序 3x4, 对应着色器中的 mat3x4 / 转置后的 mat4x3
+        };
+
+        explicit TransformPool(Storage storage = Storage::Matrix4x4);
+        ~TransformPool() = default;
+
+        TransformPool(const TransformPool& other) = delete;
+        TransformPool& operator = (const TransformPool& other) = delete;
+
+        /**
+         * @brief 默认变换池
+         * @details 默认构造的 Transform 由此分配
+         * @return 变换池
+         */
+        static TransformPool& global();
+
+        /**
+         * @brief 分配单位变换
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 句柄
+         */
+        Handle allocate();
+
+        /**
+         * @brief 分配与 source 状态相同的变换
+         * @details 他似乎不需要详细注释[划掉]
+         * @param source 源句柄
+         * @return 句柄
+         */
+        Handle clone(Handle source);
+
+        /**
+         * @brief 复制变换状态
+         * @details 他似乎不需要详细注释[划掉]
+         * @param target 目标句柄
+         * @param source 源句柄
+         */
+        void copy(Handle target, Handle source);
+
+        /**
+         * @brief 释放变换
+         * @details 槽位进入空闲表, 之后的分配会复用
+         * @param handle 句柄
+         */
+        void release(Handle handle);
+
+        void setPosition(Handle handle, const glm::vec3& vec);
+        void setRotation(Handle handle, const glm::quat& quat);
+        void setScale(Handle handle, const glm::vec3& vec);
+        void setOrigin(Handle handle, const glm::vec3& vec);
+        void setInverse(Handle handle, bool isInverse);
+
+        [[nodiscard]] glm::vec3 position(Handle handle) const;
+        [[nodiscard]] glm::quat rotation(Handle handle) const;
+        [[nodiscard]] glm::vec3 scale(Handle handle) const;
+        [[nodiscard]] glm::vec3 origin(Handle handle) const;
+        [[nodiscard]] bool inverse(Handle handle) const;
+
+        [[nodiscard]] bool isDirty(Handle handle) const;
+
+        /**
+         * @brief 变换版本
+         * @details 每次修改[含槽位重新分配]递增, 不随矩阵合成清零, 供缓存派生结果的使用方判断变化
+         * @param handle 句柄
+         * @return 版本
+         */
+        [[nodiscard]] uint32_t version(Handle handle) const;
+
+        /**
+         * @brief 取变换矩阵
+         * @details 脏时单独以标量路径合成, 与批量路径共用同一份合成代码
+         * @param handle 句柄
+         * @return 变换矩阵
+         */
+        glm::mat4 matrix(Handle handle);
+
+        /**
+         * @brief 取按存放格式排列的矩阵数据
+         * @details 脏时先合成; 返回的指针在下一次分配前有效
+         * @param handle 句柄
+         * @return stride() 个 float
+         */
+        const float* rows(Handle handle);
+
+        /**
+         * @brief 批量合成全部脏矩阵
+         * @details 按组跳过没有脏槽位的部分, 组内有逆变换槽位时再以同样的批量方式合成一遍逆矩阵
+         */
+        void update();
+
+        /**
+         * @brief 存活的变换数量
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 数量
+         */
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * @brief 脏变换数量
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 数量
+         */
+        [[nodiscard]] size_t dirtyCount() const;
+
+        /**
+         * @brief 槽位数量[含空闲槽位]
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 数量
+         */
+        [[nodiscard]] size_t capacity() const;
+
+        [[nodiscard]] Storage storage() const;
+
+        /**
+         * @brief 单个矩阵占用的 float 个数
+         * @details 4x4 为 16, 3x4 为 12
+         * @return 个数
+         */
+        [[nodiscard]] size_t stride() const;
+
+        /**
+         * @brief 全部槽位的矩阵数据
+         * @details 供整体上传, 共 capacity() * stride() 个 float; 上传前需先 update
+         * @return 数据指针
+         */
+        [[nodiscard]] const float* data() const;
+
+    private:
+        Storage _storage;
+        size_t _stride;
+        // 位置/旋转[四元数]/缩放/原点的各分量
+        std::vector<float> _px, _py, _pz;
+        std::vector<float> _rx, _ry, _rz, _rw;
+        std::vector<float> _sx, _sy, _sz;
+        std::vector<float> _ox, _oy, _oz;
+        std::vector<uint8_t> _dirty;
+        std::vector<uint8_t> _inverse;
+        std::vector<uint32_t> _versions;
+        std::vector<float> _matrices;
+        std::vector<Handle> _free;
+        size_t _dirtyCount{0};
+
+        void markDirty(Handle handle);
+
+        /**
+         * @brief 扩充一组槽位
+         * @details 他似乎不需要详细注释[划掉]
+         */
+        void grow();
+
+        /**
+         * @brief 以标量路径合成单个矩阵
+         * @details 他似乎不需要详细注释[划掉]
+         * @param handle 句柄
+         */
+        void compose(Handle handle);
+
+        /**
+         * @brief 合成一组矩阵
+         * @details 只写回 mask 中为真的槽位
+         * @param first 组内首个槽位
+         * @param mask 组内各槽位是否写回
+         */
+        void composeBatch(size_t first, const uint8_t* mask);
+};
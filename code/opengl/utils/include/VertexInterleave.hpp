@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VERTEX_INTERLEAVE_SSE 1
+#endif
+
+/**
+ * @brief 顶点交错内核
+ * @details 输出缓冲区由调用方按最终大小一次性分配, 内核直接按步长写入;
+ * 对最常见的 float 3 + 2 + 3 布局提供 SSE 特化路径, 其余布局走按元素长度特化的标量路径
+ */
+namespace interleave {
+    /**
+     * @brief 交错源列
+     * @tparam T 缓冲区类型
+     */
+    template<typename T>
+    struct Column {
+        const T* source;
+        size_t length;
+        size_t count;   // source 中 T 的个数
+    };
+
+    /**
+     * @brief 拷贝单个元素
+     * @details 常见长度展开为定长拷贝, 避免逐元素的循环与分支
+     */
+    template<typename T>
+    inline void copyElement(const T* src, T* out, const size_t length) {
+        switch (length) {
+            case 1: out[0] = src[0]; break;
+            case 2: out[0] = src[0]; out[1] = src[1]; break;
+            case 3: out[0] = src[0]; out[1] = src[1]; out[2] = src[2]; break;
+            case 4: out[0] = src[0]; out[1] = src[1]; out[2] = src[2]; out[3] = src[3]; break;
+            default: std::copy_n(src, length, out); break;
+        }
+    }
+
+    template<typename T>
+    inline bool isPosUvNormal(const std::vector<Column<T>>& columns) {
+        return std::is_same_v<T, float>
+            && columns.size() == 3
+            && columns[0].length == 3
+            && columns[1].length == 2
+            && columns[2].length == 3;
+    }
+
+#ifdef VERTEX_INTERLEAVE_SSE
+    /**
+     * @brief 组装一个 3 + 2 + 3 交错顶点
+     * @details p 与 n 各读取 4 个 float, 调用方需保证多读的 1 个 float 不越界
+     */
+    inline void vertex323(const float* p, const float* t, const float* n, float* out) {
+        const __m128 a = _mm_loadu_ps(p);
+        const __m128 b = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(t)));
+        const __m128 c = _mm_loadu_ps(n);
+        // [p0 p1 p2 t0] [t1 n0 n1 n2]
+        const __m128 lo = _mm_shuffle_ps(a, _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+        const __m128 hi = _mm_shuffle_ps(_mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 0, 1, 1)), c, _MM_SHUFFLE(2, 1, 2, 0));
+        _mm_storeu_ps(out, lo);
+        _mm_storeu_ps(out + 4, hi);
+    }
+#endif
+
+    /**
+     * @brief 按顺序交错
+     * @details 第 i 个输出顶点由各列第 i 个元素拼接而成
+     * @param columns 源列[location顺序]
+     * @param vertexCount 顶点数量
+     * @param stride 输出步长[T 的个数]
+     * @param out 输出缓冲区[至少 vertexCount * stride]
+     */
+    template<typename T>
+    void sequential(const std::vector<Column<T>>& columns, const size_t vertexCount, const size_t stride, T* out) {
+        size_t v{0};
+#ifdef VERTEX_INTERLEAVE_SSE
+        if constexpr (std::is_same_v<T, float>) {
+            if (isPosUvNormal(columns) && stride == 8) {
+                // 最后一个顶点的 4 float 读取会越界, 交给标量路径
+                for (; v + 1 < vertexCount; v++) {
+                    vertex323(columns[0].source + v * 3, columns[1].source + v * 2, columns[2].source + v * 3, out + v * 8);
+                }
+            }
+        }
+#endif
+        for (; v < vertexCount; v++) {
+            T* target = out + v * stride;
+            for (const auto& e : columns) {
+                copyElement(e.source + v * e.length, target, e.length);
+                target += e.length;
+            }
+        }
+    }
+
+    /**
+     * @brief 按索引交错
+     * @details 每个面角在 indices 中占 columns.size() 个连续索引, 依次对应各列
+     * @param columns 源列[location顺序]
+     * @param indices 面角索引
+     * @param cornerCount 面角数量
+     * @param stride 输出步长[T 的个数]
+     * @param out 输出缓冲区[至少 cornerCount * stride]
+     */
+    template<typename T>
+    void gather(const std::vector<Column<T>>& columns, const unsigned int* indices, const size_t cornerCount, const size_t stride, T* out) {
+        const size_t elementCount = columns.size();
+#ifdef VERTEX_INTERLEAVE_SSE
+        if constexpr (std::is_same_v<T, float>) {
+            if (isPosUvNormal(columns) && stride == 8) {
+                // 索引小于 safe 的顶点可安全多读 1 个 float
+                const size_t pSafe = columns[0].count >= 4 ? (columns[0].count - 4) / 3 + 1 : 0;
+                const size_t nSafe = columns[2].count >= 4 ? (columns[2].count - 4) / 3 + 1 : 0;
+                for (size_t c = 0; c < cornerCount; c++) {
+                    const unsigned int* corner = indices + c * 3;
+                    float* target = out + c * 8;
+                    if (corner[0] < pSafe && corner[2] < nSafe) {
+                        vertex323(columns[0].source + corner[0] * 3, columns[1].source + corner[1] * 2, columns[2].source + corner[2] * 3, target);
+                    } else {
+                        copyElement(columns[0].source + corner[0] * 3, target, 3);
+                        copyElement(columns[1].source + corner[1] * 2, target + 3, 2);
+                        copyElement(columns[2].source + corner[2] * 3, target + 5, 3);
+                    }
+                }
+                return;
+            }
+        }
+#endif
+        for (size_t c = 0; c < cornerCount; c++) {
+            const unsigned int* corner = indices + c * elementCount;
+            T* target = out + c * stride;
+            for (size_t i = 0; i < elementCount; i++) {
+                const auto& e = columns[i];
+                copyElement(e.source + e.length * corner[i], target, e.length);
+                target += e.length;
+            }
+        }
+    }
+}
@@ -1,13 +1,20 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 #include <iostream>
 
 #include "GlobalLogger.hpp"
+#include "VertexInterleave.hpp"
 
 /**
  * @brief 缓冲区组装布局
@@ -16,6 +23,31 @@
 template<typename T>
 class VertexLayout {
     public:
+        static constexpr size_t maxDirtySpans{8};
+
+        /**
+         * @brief 缓存组装方式
+         */
+        enum class AssemblyMode {
+            None,
+            Sequential,     // assemblyBuffer
+            Expand,         // ExpandIndices
+            Weld            // WeldIndices
+        };
+
+        /**
+         * @brief 缓存中的字节区间
+         */
+        struct ByteRange {
+            size_t offset;
+            size_t size;
+        };
+
+        using SequentialKernel = void (*)(const std::vector<interleave::Column<T>>&, size_t, size_t, T*);
+        using GatherKernel = void (*)(const std::vector<interleave::Column<T>>&, const unsigned int*, size_t, size_t, T*);
+
+        class Builder;
+
         /**
          * @brief 布局元素
          */
@@ -28,6 +60,7 @@ class VertexLayout {
                 size_t origin{};
                 size_t step{};
                 bool* _isDirty{};
+                mutable std::vector<std::pair<size_t, size_t>> _dirtySpans;   // 按起点排序且互不相接的顶点区间
 
                 /**
                  * @brief 元素构造
@@ -56,25 +89,113 @@ class VertexLayout {
                 }
 
                 /**
-                 * @brief 配置数据源[拷贝]
+                 * @brief 区间脏标记
+                 * @details 仅标记本元素的顶点区间[begin, end), 与已有区间重叠或相接时合并, 否则单独记录;
+                 * 区间数超过 maxDirtySpans 时合并间隙最小的相邻两个区间; 下次组装时只重写该列的这些区间
+                 * @param begin 起始顶点
+                 * @param end 结束顶点[不含]
+                 */
+                void dirtyRange(size_t begin, size_t end) const {
+                    if (begin >= end) return;
+                    auto first = std::lower_bound(_dirtySpans.begin(), _dirtySpans.end(), begin, [](const auto& span, size_t value) {
+                        return span.second < value;
+                    });
+                    auto last = first;
+                    for (; last != _dirtySpans.end() && last->first <= end; ++last) {
+                        begin = std::min(begin, last->first);
+                        end = std::max(end, last->second);
+                    }
+                    _dirtySpans.insert(_dirtySpans.erase(first, last), {begin, end});
+                    if (_dirtySpans.size() <= maxDirtySpans) return;
+                    size_t closest{1};
+                    for (size_t i = 2; i < _dirtySpans.size(); i++) {
+                        if (_dirtySpans[i].first - _dirtySpans[i - 1].second < _dirtySpans[closest].first - _dirtySpans[closest - 1].second) closest = i;
+                    }
+                    _dirtySpans[closest - 1].second = _dirtySpans[closest].second;
+                    _dirtySpans.erase(_dirtySpans.begin() + static_cast<std::ptrdiff_t>(closest));
+                }
+
+                /**
+                 * @brief 是否存在区间脏标记
                  * @details 他似乎不需要详细注释[划掉]
+                 * @return 他似乎不需要注释[划掉]
+                 */
+                [[nodiscard]] bool hasDirtyRange() const {
+                    return !_dirtySpans.empty();
+                }
+
+                /**
+                 * @brief 顶点是否落在脏区间内
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @param index 顶点
+                 * @return 他似乎不需要注释[划掉]
+                 */
+                [[nodiscard]] bool inDirtyRange(size_t index) const {
+                    const auto it = std::upper_bound(_dirtySpans.begin(), _dirtySpans.end(), index, [](size_t value, const auto& span) {
+                        return value < span.first;
+                    });
+                    return it != _dirtySpans.begin() && index < std::prev(it)->second;
+                }
+
+                /**
+                 * @brief 清除区间脏标记
+                 * @details 他似乎不需要详细注释[划掉]
+                 */
+                void clearDirtyRange() const {
+                    _dirtySpans.clear();
+                }
+
+                /**
+                 * @brief 配置数据源[拷贝]
+                 * @details 数据源大小不变时仅标记本列, 否则标记整个布局
                  * @param source 数据源
                  */
                 void setSource(const std::vector<T>& source) {
                     if (_source == source) return;
+                    const bool sameSize = _source.size() == source.size();
                     _source = source;
-                    dirty();
+                    sameSize ? dirtyRange(0, _source.size() / length) : dirty();
                 }
 
                 /**
                  * @brief 配置数据源[移动]
-                 * @details 他似乎不需要详细注释[划掉]
+                 * @details 数据源大小不变时仅标记本列, 否则标记整个布局
                  * @param source 数据源
                  */
                 void setSource(std::vector<T>&& source) {
                     if (_source == source) return;
+                    const bool sameSize = _source.size() == source.size();
                     _source = std::move(source);
-                    dirty();
+                    sameSize ? dirtyRange(0, _source.size() / length) : dirty();
+                }
+
+                /**
+                 * @brief 原位更新部分数据源
+                 * @details 写入从 first 开始的若干个完整元素, 并仅标记对应的顶点区间
+                 * @param first 起始顶点
+                 * @param values 新数据[长度须为元素长度的整数倍]
+                 * @param count 新数据中 T 的个数
+                 * @return 是否更新成功
+                 */
+                bool updateSource(size_t first, const T* values, size_t count) {
+                    if (count % length != 0 || first * length + count > _source.size()) {
+                        glog.log<DefaultLevel::Warn>("错误: [" + identifier + "]元素的更新区间越界或未按元素对齐");
+                        return false;
+                    }
+                    std::copy_n(values, count, _source.begin() + first * length);
+                    dirtyRange(first, first + count / length);
+                    return true;
+                }
+
+                /**
+                 * @brief 原位更新部分数据源
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @param first 起始顶点
+                 * @param values 新数据[长度须为元素长度的整数倍]
+                 * @return 是否更新成功
+                 */
+                bool updateSource(size_t first, const std::vector<T>& values) {
+                    return updateSource(first, values.data(), values.size());
                 }
 
                 /**
@@ -241,6 +362,20 @@ class VertexLayout {
                     return true;
                 }
 
+                /**
+                 * @brief 构建时绑定编译期顶点格式
+                 * @details 构建出的布局与格式不符时忽略绑定, 保留运行时交错路径
+                 * @tparam Format 编译期顶点格式[vertex_format::Format]
+                 * @return 构建者引用
+                 */
+                template<typename Format>
+                Builder& format() {
+                    formatBinder = [](VertexLayout& layout) {
+                        layout.template bindFormat<Format>();
+                    };
+                    return *this;
+                }
+
                 /**
                  * @brief 构建缓冲区组装布局
                  * @details 他似乎不需要详细注释[划掉]
@@ -254,10 +389,15 @@ class VertexLayout {
                     for (auto& e : elements) {
                         e.step = originCounter * sizeof(T);
                     }
-                    return VertexLayout(std::move(elements), std::move(identifierMap), std::move(rawIndices));
+                    VertexLayout layout(std::move(elements), std::move(identifierMap), std::move(rawIndices));
+                    if (formatBinder != nullptr) {
+                        formatBinder(layout);
+                    }
+                    return layout;
                 }
 
             private:
+                void (*formatBinder)(VertexLayout&){nullptr};
                 std::vector<LayoutElement> elements;
                 std::map<std::string, size_t> identifierMap;
                 std::vector<unsigned int> rawIndices;
@@ -295,9 +435,12 @@ class VertexLayout {
             _layout(std::move(other._layout)),
             _cache(std::move(other._cache)),
             _indices(std::move(other._indices)),
+            _indices16(std::move(other._indices16)),
             _rawIndices(std::move(other._rawIndices)),
             _identifierMap(std::move(other._identifierMap)),
-            _isDirty(true)
+            _isDirty(true),
+            _sequentialKernel(other._sequentialKernel),
+            _gatherKernel(other._gatherKernel)
             {
                 size_t index{0};
                 for (LayoutElement& e : _layout) {
@@ -318,8 +461,11 @@ class VertexLayout {
                 _layout = std::move(other._layout);
                 _cache = std::move(other._cache);
                 _indices = std::move(other._indices);
+                _indices16 = std::move(other._indices16);
                 _rawIndices = std::move(other._rawIndices);
                 _identifierMap = std::move(other._identifierMap);
+                _sequentialKernel = other._sequentialKernel;
+                _gatherKernel = other._gatherKernel;
                 _isDirty = true;
                 for (LayoutElement& e : _layout) {
                     e._isDirty = &this->_isDirty;
@@ -354,37 +500,26 @@ class VertexLayout {
          * @return 缓冲区引用
          */
         const std::vector<T>& assemblyBuffer() const {
-            if (!_isDirty) {
+            if (!_isDirty && _cacheMode == AssemblyMode::Sequential) {
+                refreshDirtyRanges();
                 return _cache;
             }
-            size_t size{};
-            for (const auto& e : _layout) {
-                size += e._source.size();
-            }
-            _cache.clear();
-            _cache.reserve(size);
-            _indices.clear();
-            _indices.reserve(size);
-
-            size_t stepCounter{};
-            size_t indexCounter{};
-            size_t i{};
-            while (true) {
-                for (auto& e : _layout) {
-                    _cache.insert(_cache.end(), e.length, 0);
-                    std::copy_n(e._source.begin() + (e.length * stepCounter),
-                    e.length,
-                    _cache.begin() + i
-                    );
-                    i += e.length;
-                }
-                stepCounter++;
-                _indices.push_back(indexCounter);
-                indexCounter++;
-                if (i >= size) break;
+            const auto sources = columns();
+            size_t vertexCount{sources.empty() ? 0 : std::numeric_limits<size_t>::max()};
+            for (const auto& e : sources) {
+                vertexCount = std::min(vertexCount, e.count / e.length);
             }
+            const size_t stride = _layout.empty() ? 0 : _layout[0].step / sizeof(T);
+
+            _cache.resize(vertexCount * stride);
+            _sequentialKernel(sources, vertexCount, stride, _cache.data());
+            _indices.resize(vertexCount);
+            std::iota(_indices.begin(), _indices.end(), 0u);
+            _indices16.clear();
 
             _isDirty = false;
+            _cacheMode = AssemblyMode::Sequential;
+            markFullyDirty();
             return _cache;
         }
 
@@ -396,6 +531,7 @@ class VertexLayout {
         void indices(const std::vector<unsigned int>& indexStr) {
             if (!indexStr.empty()) {
                 _rawIndices = indexStr;
+                _isDirty = true;
             }
         }
 
@@ -407,18 +543,28 @@ class VertexLayout {
         void indices(std::vector<unsigned int>&& indexStr) {
             if (!indexStr.empty()) {
                 _rawIndices = std::move(indexStr);
+                _isDirty = true;
             }
         }
 
         /**
          * @brief 获取原始索引数组
          * @details 他似乎不需要详细注释[划掉]
-         * @return 原始索引数组
+         * @return 原始索引数组引用
          */
-        std::vector<unsigned int> rawIndices() const {
+        const std::vector<unsigned int>& rawIndices() const {
             return _rawIndices;
         }
 
+        /**
+         * @brief 获取全部布局元素
+         * @details 按location顺序排列
+         * @return 布局元素数组引用
+         */
+        const std::vector<LayoutElement>& elements() const {
+            return _layout;
+        }
+
 
         /**
          * @brief 通过索引组装缓冲区
@@ -426,7 +572,8 @@ class VertexLayout {
          * @return 缓冲区引用
          */
         const std::vector<T>& ExpandIndices() const {
-            if (!_isDirty) {
+            if (!_isDirty && _cacheMode == AssemblyMode::Expand) {
+                refreshDirtyRanges();
                 return _cache;
             }
             if (_rawIndices.empty()) {
@@ -434,46 +581,168 @@ class VertexLayout {
                 return _cache;
             }
 
-            size_t size = (_rawIndices.size() / _layout.size()) * (_layout[0].step / sizeof(T));
+            const size_t stride = _layout[0].step / sizeof(T);
+            const size_t corners = _rawIndices.size() / _layout.size();
+            _cache.resize(corners * stride);
+            _gatherKernel(columns(), _rawIndices.data(), corners, stride, _cache.data());
+            _indices.resize(corners);
+            std::iota(_indices.begin(), _indices.end(), 0u);
+            _indices16.clear();
+
+            _isDirty = false;
+            _cacheMode = AssemblyMode::Expand;
+            markFullyDirty();
+            return _cache;
+        }
+
+        /**
+         * @brief 通过索引组装缓冲区并焊接重复顶点
+         * @details 按location顺序拼接每个面角的元素得到交错顶点, 以逐位内容哈希去重, 缓冲区中仅保留唯一顶点并生成真实索引;
+         * 唯一顶点数可由 16 位索引表示时同时生成 16 位索引. 按索引展开焊接结果与 ExpandIndices 的结果逐位一致
+         * @return 缓冲区引用
+         */
+        const std::vector<T>& WeldIndices() const {
+            // 存在被合并的不同源索引组合时, 局部更新可能使合并失效, 只能重新焊接
+            if (!_isDirty && _cacheMode == AssemblyMode::Weld && !(_weldAliased && hasDirtyRange())) {
+                refreshDirtyRanges();
+                return _cache;
+            }
+            if (_rawIndices.empty()) {
+                glog.log<DefaultLevel::Warn>("错误: 使用索引缓冲区组装时索引未空");
+                return _cache;
+            }
+
+            const size_t elementCount = _layout.size();
+            const size_t stride = _layout[0].step / sizeof(T);
+            const size_t corners = _rawIndices.size() / elementCount;
             _cache.clear();
-            _cache.reserve(size);
+            _cache.reserve(corners * stride);
             _indices.clear();
-            _indices.reserve(_rawIndices.size() / (_layout[0].step / sizeof(T)));
-
-            size_t i{};
-            size_t stepCounter{0};
-            size_t elementIndex{0};
-            size_t indexCounter{0};
-            for (const auto& index : _rawIndices) {
-                auto& e = _layout.at(elementIndex);
-                _cache.insert(_cache.end(), e.length, 0);
-                std::copy_n(e._source.begin() + (e.length * index),
-                    e.length,
-                    _cache.begin() + i
-                    );
-                i += e.length;
-                stepCounter++;
-                elementIndex++;
-                elementIndex %= _layout.size();
-
-                if (elementIndex == 0) {
-                    _indices.push_back(indexCounter);
-                    indexCounter++;
+            _indices.reserve(corners);
+
+            // 开放寻址表, 存放顶点序号 + 1, 0 表示空槽
+            size_t capacity{16};
+            while (capacity < corners * 2) capacity <<= 1;
+            std::vector<unsigned int> table(capacity, 0);
+            std::vector<T> vertex(stride);
+            unsigned int vertexCount{0};
+            _weldCorners.clear();
+            _weldAliased = false;
+
+            for (size_t corner = 0; corner < corners; corner++) {
+                T* out = vertex.data();
+                const unsigned int* cornerIndices = _rawIndices.data() + corner * elementCount;
+                for (size_t i = 0; i < elementCount; i++) {
+                    const auto& e = _layout[i];
+                    interleave::copyElement(e._source.data() + (e.length * cornerIndices[i]), out, e.length);
+                    out += e.length;
+                }
+
+                size_t slot = hashVertex(vertex.data(), stride) & (capacity - 1);
+                while (true) {
+                    const unsigned int id = table[slot];
+                    if (id == 0) {
+                        table[slot] = vertexCount + 1;
+                        _cache.insert(_cache.end(), vertex.begin(), vertex.end());
+                        _indices.push_back(vertexCount);
+                        _weldCorners.push_back(static_cast<unsigned int>(corner));
+                        vertexCount++;
+                        break;
+                    }
+                    if (std::memcmp(_cache.data() + (id - 1) * stride, vertex.data(), stride * sizeof(T)) == 0) {
+                        _indices.push_back(id - 1);
+                        _weldAliased = _weldAliased || !std::equal(cornerIndices, cornerIndices + elementCount,
+                            _rawIndices.data() + _weldCorners[id - 1] * elementCount);
+                        break;
+                    }
+                    slot = (slot + 1) & (capacity - 1);
                 }
             }
+            _cache.shrink_to_fit();
+
+            _indices16.clear();
+            if (vertexCount <= std::numeric_limits<uint16_t>::max()) {
+                _indices16.assign(_indices.begin(), _indices.end());
+            }
             _isDirty = false;
+            _cacheMode = AssemblyMode::Weld;
+            markFullyDirty();
             return _cache;
         }
 
         /**
-         * @brief 获取通过索引组装的缓冲区的索引[毫无作用][划掉]
-         * @details 他似乎不需要详细注释[划掉]
+         * @brief 获取组装缓冲区的索引
+         * @details 经 WeldIndices 组装时为真实索引, 经 assemblyBuffer/ExpandIndices 组装时为顺序索引
          * @return 索引数组引用
          */
         const std::vector<unsigned int>& bufferOfIndices() const {
             return _indices;
         }
 
+        /**
+         * @brief 获取组装缓冲区的 16 位索引
+         * @details 仅在 WeldIndices 组装且唯一顶点数可由 16 位表示时非空
+         * @return 索引数组引用
+         */
+        const std::vector<uint16_t>& bufferOfIndices16() const {
+            return _indices16;
+        }
+
+        /**
+         * @brief 获取自上次清除以来缓存中被重写的字节区间
+         * @details 整体重建时为覆盖整个缓存的单个区间, 局部更新时为按偏移排序且互不重叠的区间, 可直接用于部分上传
+         * @return 字节区间数组引用
+         */
+        const std::vector<ByteRange>& dirtyRanges() const {
+            return _dirtyRanges;
+        }
+
+        /**
+         * @brief 清除已记录的字节区间
+         * @details 通常在完成上传后调用
+         */
+        void clearDirtyRanges() const {
+            _dirtyRanges.clear();
+        }
+
+        /**
+         * @brief 当前缓存组装方式
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 组装方式
+         */
+        AssemblyMode assemblyMode() const {
+            return _isDirty ? AssemblyMode::None : _cacheMode;
+        }
+
+        /**
+         * @brief 绑定编译期顶点格式
+         * @details 格式与当前布局一致时, assemblyBuffer/ExpandIndices 改用格式在编译期展开的交错内核
+         * @tparam Format 编译期顶点格式[vertex_format::Format]
+         * @return 是否绑定成功
+         */
+        template<typename Format>
+        bool bindFormat() {
+            static_assert(std::is_same_v<typename Format::ValueType, T>, "错误: 顶点格式类型与缓冲区类型不一致");
+            if (!Format::matches(*this)) {
+                glog.log<DefaultLevel::Warn>("错误: 顶点格式与当前布局不一致, 保留运行时路径");
+                return false;
+            }
+            _sequentialKernel = &Format::sequential;
+            _gatherKernel = &Format::gather;
+            _isDirty = true;
+            return true;
+        }
+
+        /**
+         * @brief 解除编译期顶点格式绑定
+         * @details 他似乎不需要详细注释[划掉]
+         */
+        void resetFormat() {
+            _sequentialKernel = &interleave::sequential<T>;
+            _gatherKernel = &interleave::gather<T>;
+            _isDirty = true;
+        }
+
         /**
          * @brief 缓冲区组装布局是否包含元素
          * @details 他似乎不需要详细注释[划掉]
@@ -511,8 +780,135 @@ class VertexLayout {
         std::map<std::string, size_t> _identifierMap;
         mutable std::vector<T> _cache;
         mutable std::vector<unsigned int> _indices;
+        mutable std::vector<uint16_t> _indices16;
         std::vector<unsigned int> _rawIndices;
         mutable bool _isDirty{true};
+        mutable AssemblyMode _cacheMode{AssemblyMode::None};
+        mutable std::vector<ByteRange> _dirtyRanges;
+        mutable std::vector<unsigned int> _weldCorners;
+        mutable bool _weldAliased{false};
+        SequentialKernel _sequentialKernel{&interleave::sequential<T>};
+        GatherKernel _gatherKernel{&interleave::gather<T>};
+
+        /**
+         * @brief 是否有元素存在区间脏标记
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 他似乎不需要注释[划掉]
+         */
+        bool hasDirtyRange() const {
+            return std::any_of(_layout.begin(), _layout.end(), [](const LayoutElement& e) {
+                return e.hasDirtyRange();
+            });
+        }
+
+        /**
+         * @brief 整体重建后记录覆盖整个缓存的区间并清除元素的区间脏标记
+         * @details 他似乎不需要详细注释[划掉]
+         */
+        void markFullyDirty() const {
+            for (const auto& e : _layout) {
+                e.clearDirtyRange();
+            }
+            _dirtyRanges.assign(1, ByteRange{0, _cache.size() * sizeof(T)});
+        }
+
+        /**
+         * @brief 仅重写存在区间脏标记的元素列
+         * @details 顺序组装时直接按顶点区间重写; 按索引组装与焊接组装时扫描索引, 重写引用了脏区间的缓存顶点
+         */
+        void refreshDirtyRanges() const {
+            if (!hasDirtyRange()) return;
+            const size_t elementCount = _layout.size();
+            const size_t stride = _layout[0].step / sizeof(T);
+            const size_t strideBytes = stride * sizeof(T);
+            const size_t vertexCount = _cache.size() / stride;
+
+            auto record = [&](size_t first, size_t last, const LayoutElement& e) {
+                _dirtyRanges.push_back(ByteRange{first * strideBytes + e.origin, (last - first) * strideBytes - strideBytes + e.length * sizeof(T)});
+            };
+            for (const auto& e : _layout) {
+                if (!e.hasDirtyRange()) continue;
+                const size_t offset = e.origin / sizeof(T);
+                const T* source = e._source.data();
+                if (_cacheMode == AssemblyMode::Sequential) {
+                    for (const auto& [begin, spanEnd] : e._dirtySpans) {
+                        const size_t end = std::min(spanEnd, vertexCount);
+                        for (size_t v = begin; v < end; v++) {
+                            interleave::copyElement(source + v * e.length, _cache.data() + v * stride + offset, e.length);
+                        }
+                        if (begin < end) record(begin, end, e);
+                    }
+                } else {
+                    // Expand 模式下缓存顶点 i 对应面角 i, Weld 模式下对应其代表面角; 连续被重写的缓存顶点记为一个区间
+                    const bool weld = _cacheMode == AssemblyMode::Weld;
+                    size_t first{0}, last{0};
+                    for (size_t v = 0; v < vertexCount; v++) {
+                        const size_t corner = weld ? _weldCorners[v] : v;
+                        const unsigned int index = _rawIndices[corner * elementCount + e.location];
+                        if (!e.inDirtyRange(index)) continue;
+                        interleave::copyElement(source + index * e.length, _cache.data() + v * stride + offset, e.length);
+                        if (v != last) {
+                            if (first < last) record(first, last, e);
+                            first = v;
+                        }
+                        last = v + 1;
+                    }
+                    if (first < last) record(first, last, e);
+                }
+                e.clearDirtyRange();
+            }
+
+            // 排序并合并重叠或相接的区间
+            std::sort(_dirtyRanges.begin(), _dirtyRanges.end(), [](const ByteRange& a, const ByteRange& b) {
+                return a.offset < b.offset;
+            });
+            std::vector<ByteRange> merged{};
+            for (const auto& r : _dirtyRanges) {
+                if (!merged.empty() && r.offset <= merged.back().offset + merged.back().size) {
+                    merged.back().size = std::max(merged.back().offset + merged.back().size, r.offset + r.size) - merged.back().offset;
+                } else {
+                    merged.push_back(r);
+                }
+            }
+            _dirtyRanges = std::move(merged);
+        }
+
+        /**
+         * @brief 以location顺序生成交错源列
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 交错源列
+         */
+        std::vector<interleave::Column<T>> columns() const {
+            std::vector<interleave::Column<T>> out{};
+            out.reserve(_layout.size());
+            for (const auto& e : _layout) {
+                out.push_back(interleave::Column<T>{e._source.data(), e.length, e._source.size()});
+            }
+            return out;
+        }
+
+        /**
+         * @brief 交错顶点的逐位内容哈希
+         * @details 他似乎不需要详细注释[划掉]
+         * @param vertex 顶点数据
+         * @param count 元素数量
+         * @return 哈希值
+         */
+        static size_t hashVertex(const T* vertex, size_t count) {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(vertex);
+            const size_t size = count * sizeof(T);
+            uint64_t h{0xCBF29CE484222325ull};
+            size_t i{0};
+            for (; i + sizeof(uint32_t) <= size; i += sizeof(uint32_t)) {
+                uint32_t word;
+                std::memcpy(&word, bytes + i, sizeof(uint32_t));
+                h = (h ^ word) * 0x100000001B3ull;
+            }
+            for (; i < size; i++) {
+                h = (h ^ bytes[i]) * 0x100000001B3ull;
+            }
+            return static_cast<size_t>(h ^ (h >> 32));
+        }
 
         /**
          * @brief 构建者使用的缓冲区组装布局构造
@@ -526,6 +922,7 @@ class VertexLayout {
             _identifierMap(std::move(identifierMap)),
             _cache(std::vector<T>()),
             _indices(std::vector<unsigned int>()),
+            _indices16(std::vector<uint16_t>()),
             _rawIndices(std::move(rawIndices)),
             _isDirty(true) {
             size_t index{0};
@@ -38,30 +38,50 @@ namespace event {
         double y_offset;
     };
     }
+    // GLFW 回调在输入线程只做入队, 回调由渲染线程每帧 dispatch 时执行
     namespace func {
         inline void frameBuffer_size_callback(GLFWwindow *window, int width, int height) {
             types::FrameSize_Event content{window, width, height};
-            gEbus.publish("frame-size-callback", content);
+            constexpr EventBus::Topic topic = EventBus::topic("frame-size-callback");
+            gEbus.post(topic, content);
         }
 
         inline void scroll_callback(GLFWwindow *window, double x_offset, double y_offset) {
             types::MouseScroll_Event content{x_offset, y_offset};
-            gEbus.publish("mouse-scroll-callback", content);
+            constexpr EventBus::Topic topic = EventBus::topic("mouse-scroll-callback");
+            gEbus.post(topic, content);
         }
 
         inline void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods) {
             types::Keyboard_Event content{window, key, scancode, action, mods};
-            gEbus.publish("keyboard-callback", content);
+            constexpr EventBus::Topic topic = EventBus::topic("keyboard-callback");
+            gEbus.post(topic, content);
         }
 
         inline void mouse_callback(GLFWwindow *window, double x, double y) {
             types::MouseMove_Event content{window, x, y};
-            gEbus.publish("mouse-move-callback", content);
+            constexpr EventBus::Topic topic = EventBus::topic("mouse-move-callback");
+            gEbus.post(topic, content);
         }
 
         inline void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
             types::MouseButton_Event content{button, action, mods};
-            gEbus.publish("mouse-button-callback", content);
+            constexpr EventBus::Topic topic = EventBus::topic("mouse-button-callback");
+            gEbus.post(topic, content);
+        }
+
+        /**
+         * @brief 设置高频输入事件的合并方式
+         * @details 拖动与缩放窗口时每帧只回调一次: 光标位置与帧缓冲尺寸取最新, 滚动偏移累加
+         */
+        inline void coalesce_callbacks() {
+            gEbus.coalesce<types::FrameSize_Event>("frame-size-callback", EventBus::Coalesce::KeepLatest);
+            gEbus.coalesce<types::MouseMove_Event>("mouse-move-callback", EventBus::Coalesce::KeepLatest);
+            gEbus.coalesce<types::MouseScroll_Event>("mouse-scroll-callback", EventBus::Coalesce::Accumulate,
+                [](types::MouseScroll_Event& merged, const types::MouseScroll_Event& next) {
+                    merged.x_offset += next.x_offset;
+                    merged.y_offset += next.y_offset;
+                });
         }
     }
 }
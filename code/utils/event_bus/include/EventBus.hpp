@@ -1,14 +1,76 @@
 #pragma once
-#include <iostream>
-#include <typeindex>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
-#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
+/**
+ * @brief 事件总线
+ * @details 订阅按 [事件类型编号, 事件标识符哈希] 分组, 整理为只读快照: 分组有序平铺, 回调连续存放;
+ * 订阅/退订加锁复制出新快照后原子替换[读-复制-更新], 发布只做原子计数与二分查找, 不加锁、不分配、不使用 RTTI;
+ * 被替换的快照在确认没有发布者仍在读取后释放[替换时无读者则立即释放, 否则由最后离开的读者释放];
+ * 另有排队投递: post 把事件复制进有界多生产者单消费者环形队列, 由持有状态的线程每帧 dispatch 一次批量回调;
+ * 排队的事件可按分组合并[只保留最新/累加], 一次 dispatch 中每个分组至多回调一次合并后的事件
+ */
 class EventBus {
     public:
-        EventBus() = default;
-        ~EventBus() = default;
+        using Topic = uint64_t;
+        static constexpr size_t queueEventSize{32};
+
+        /**
+         * @brief 排队事件的合并方式
+         */
+        enum class Coalesce : uint8_t {
+            KeepAll,        // 逐个回调[默认]
+            KeepLatest,     // 只回调最后一个
+            Accumulate      // 以合并函数累加后回调一次
+        };
+
+        /**
+         * @brief 事件总线构造
+         * @details 他似乎不需要详细注释[划掉]
+         * @param queueCapacity 排队投递的队列容量[向上取 2 的幂]
+         */
+        explicit EventBus(size_t queueCapacity = 1024) {
+            size_t capacity{2};
+            while (capacity < queueCapacity) capacity <<= 1;
+            _queue = std::make_unique<QueueSlot[]>(capacity);
+            _queueMask = capacity - 1;
+            for (size_t i = 0; i < capacity; i++) {
+                _queue[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~EventBus() {
+            delete _table.load();
+        }
+
+        EventBus(const EventBus& other) = delete;
+        EventBus& operator = (const EventBus& other) = delete;
+
+        /**
+         * @brief 计算事件标识符
+         * @details FNV-1a 64 位哈希, 可在编译期对字面量求值后直接发布
+         * @param identifier 事件标识符
+         * @return 标识符哈希
+         */
+        static constexpr Topic topic(std::string_view identifier) {
+            Topic hash{14695981039346656037ull};
+            for (const char c : identifier) {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
 
         /**
          * @brief 发布事件
@@ -20,19 +82,120 @@ class EventBus {
         template<typename EventType>
         void publish(const std::string& identifier, EventType& content) const {
             if (identifier.empty()) return;
-            if (_subscriptionMap.empty()) return;
-
-            if (const auto typeMap_it = _subscriptionMap.find(typeid(EventType)); typeMap_it != _subscriptionMap.end()) {
-                if (typeMap_it->second.empty()) return;
-                if (const auto identifierMap_it = typeMap_it->second.find(identifier); identifierMap_it != typeMap_it->second.end()) {
-                    if (identifierMap_it->second.empty()) return;
-                    for (auto& [call, id] : identifierMap_it->second) {
-                        if (auto* wrapper = dynamic_cast<CallWrapper<EventType&>*>(call.get())) {
-                            wrapper->call(content);
-                        }
-                    }
+            publish(topic(identifier), content);
+        }
+
+        /**
+         * @brief 按预先计算的标识符发布事件
+         * @details 回调内可以订阅或退订, 本次发布仍按发布开始时的快照进行
+         * @tparam EventType 事件类型
+         * @param identifier 标识符哈希
+         * @param content 事件内容
+         */
+        template<typename EventType>
+        void publish(Topic identifier, EventType& content) const {
+            const ReadGuard guard{*this};
+            const Table* table = _table.load();
+            if (table == nullptr) return;
+
+            const Channel* channel = find(*table, typeId<EventType>(), identifier);
+            if (channel == nullptr) return;
+            const Subscriber* subscriber = table->subscribers.data() + channel->first;
+            for (const Subscriber* end = subscriber + channel->count; subscriber != end; subscriber++) {
+                subscriber->invoke(subscriber->call, &content);
+            }
+        }
+
+        /**
+         * @brief 排队投递事件
+         * @details 只复制事件进队列, 回调在 dispatch 的线程执行; 可在任意线程调用, 不加锁、不分配;
+         * 事件须可平凡复制且不超过 queueEventSize 字节
+         * @tparam EventType 事件类型
+         * @param identifier 标识符哈希
+         * @param content 事件内容
+         * @return 是否入队[队列已满时丢弃]
+         */
+        template<typename EventType>
+        bool post(Topic identifier, const EventType& content) const {
+            static_assert(std::is_trivially_copyable_v<EventType>, "排队投递的事件须可平凡复制");
+            static_assert(sizeof(EventType) <= queueEventSize && alignof(EventType) <= alignof(std::max_align_t), "排队投递的事件过大");
+
+            size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+            QueueSlot* slot{nullptr};
+            for (;;) {
+                slot = &_queue[position & _queueMask];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+                if (difference == 0) {
+                    if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = _enqueuePosition.load(std::memory_order_relaxed);
                 }
             }
+            slot->topic = identifier;
+            slot->deliver = &deliver<EventType>;
+            slot->type = typeId<EventType>();
+            new (slot->content) EventType(content);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief 回调已排队的事件
+         * @details 按入队顺序逐个发布, 设置了合并方式的分组先合并, 在本次处理结束时按首次出现的顺序发布;
+         * 只能由一个线程调用[单消费者], 通常为渲染线程每帧一次
+         * @param limit 本次最多处理的事件数[默认为队列容量, 生产者持续投递时也会返回]
+         * @return 处理的事件数
+         */
+        size_t dispatch(size_t limit = 0) const {
+            if (limit == 0) limit = _queueMask + 1;
+            size_t count{0};
+            const ReadGuard guard{*this};
+            const Table* table = _table.load();
+            while (count < limit) {
+                QueueSlot& slot = _queue[_dequeuePosition & _queueMask];
+                if (slot.sequence.load(std::memory_order_acquire) != _dequeuePosition + 1) break;
+                const Channel* channel = table == nullptr ? nullptr : find(*table, slot.type, slot.topic);
+                if (channel == nullptr || channel->coalesce == Coalesce::KeepAll) {
+                    slot.deliver(*this, slot.topic, slot.content);
+                } else {
+                    merge(*channel, slot);
+                }
+                slot.sequence.store(_dequeuePosition + _queueMask + 1, std::memory_order_release);
+                _dequeuePosition++;
+                count++;
+            }
+            for (auto& pending : _pending) {
+                pending.deliver(*this, pending.topic, pending.content);
+            }
+            _pending.clear();
+            return count;
+        }
+
+        /**
+         * @brief 设置排队事件的合并方式
+         * @details 只作用于 post/dispatch, 同步 publish 不合并; Accumulate 未给出合并函数时按 KeepLatest 处理
+         * @tparam EventType 事件类型
+         * @param identifier 事件标识符
+         * @param policy 合并方式
+         * @param merge 合并函数[把 next 累加进 merged]
+         */
+        template<typename EventType>
+        void coalesce(const std::string& identifier, Coalesce policy, std::function<void(EventType& merged, const EventType& next)> merge = {}) const {
+            const std::lock_guard lock{_mutex};
+            const uint32_t type = typeId<EventType>();
+            const Topic hash = topic(identifier);
+            std::erase_if(_policies, [&](const Policy& e) { return e.type == type && e.topic == hash; });
+            if (policy == Coalesce::Accumulate && !merge) policy = Coalesce::KeepLatest;
+            Policy entry{type, hash, policy, nullptr, nullptr};
+            if (policy == Coalesce::Accumulate) {
+                entry.merge = &mergeInvoke<EventType>;
+                entry.call = std::make_shared<const std::function<void(EventType&, const EventType&)>>(std::move(merge));
+            }
+            if (policy != Coalesce::KeepAll) _policies.push_back(std::move(entry));
+            rebuild();
         }
 
         /**
@@ -45,9 +208,17 @@ class EventBus {
          */
         template<typename EventType>
         size_t subscribe(const std::string& identifier, std::function<void(EventType&)> call) const {
-            _subscriptionMap[typeid(EventType)][identifier].emplace_back(CallInfo{std::make_unique<CallWrapper<EventType&>>(call), _idCounter});
-            _idCounter++;
-            return _idCounter - 1;
+            const std::lock_guard lock{_mutex};
+            const size_t id = _idCounter++;
+            _entries.push_back(Entry{
+                typeId<EventType>(),
+                topic(identifier),
+                id,
+                &invoke<EventType>,
+                std::make_shared<const std::function<void(EventType&)>>(std::move(call))
+            });
+            rebuild();
+            return id;
         }
 
         /**
@@ -59,64 +230,240 @@ class EventBus {
          */
         template<typename EventType>
         void unsubscribe(const std::string& identifier, size_t id) {
-            auto type_it = _subscriptionMap.find(typeid(EventType));
-            if (type_it == _subscriptionMap.end()) return;
-
-            auto identifier_it = type_it->second.find(identifier);
-            if (identifier_it == type_it->second.end()) return;
-
-            for (auto i = identifier_it->second.begin(); i != identifier_it->second.end(); i++) {
-                if (i->id == id) {
-                    identifier_it->second.erase(i);
-                    return;
-                }
-            }
+            const std::lock_guard lock{_mutex};
+            const uint32_t type = typeId<EventType>();
+            const Topic hash = topic(identifier);
+            const auto it = std::find_if(_entries.begin(), _entries.end(), [&](const Entry& e) {
+                return e.id == id && e.type == type && e.topic == hash;
+            });
+            if (it == _entries.end()) return;
+            _entries.erase(it);
+            rebuild();
         }
 
     private:
+        using Invoke = void (*)(const void* call, void* content);
+        using Merge = void (*)(const void* call, void* merged, const void* next);
+        using Deliver = void (*)(const EventBus& bus, Topic identifier, void* content);
+
         /**
-         * @brief 回调类型擦除基类
-         * @details 他似乎不需要详细注释[划掉]
+         * @brief 快照中的回调
+         * @details 以函数指针还原回调类型, 所属分组已保证事件类型一致
          */
-        class CallBase {
-            public:
-                virtual ~CallBase() = default;
-                virtual void call() {
-                    std::cout << "空" << std::endl;
-                }
-            };
+        struct Subscriber {
+            Invoke invoke;
+            const void* call;
+        };
 
         /**
-         * @brief 类型擦除回调包装器
-         * @tparam CallType 回调类型
+         * @brief 快照中的分组
+         * @details subscribers 中 [first, first + count) 为该分组的回调, 按订阅顺序排列;
+         * 只设置了合并方式的分组 count 为 0
          */
-        template<typename CallType>
-        class CallWrapper: public CallBase{
-            public:
-                CallWrapper(std::function<void(CallType&)> call): _call(call) {}
-                ~CallWrapper() override = default;
-
-                void call(CallType& content) {
-                    _call(content);
-                }
+        struct Channel {
+            uint32_t type;
+            Topic topic;
+            uint32_t first;
+            uint32_t count;
+            Coalesce coalesce{Coalesce::KeepAll};
+            Merge merge{nullptr};
+            const void* mergeCall{nullptr};
+        };
 
-                void operator () (CallType& content) {
-                    call(content);
-                }
-            private:
-                std::function<void(CallType&)> _call;
+        /**
+         * @brief 只读快照
+         * @details owners 持有回调对象, 旧快照释放前回调不会被销毁
+         */
+        struct Table {
+            std::vector<Channel> channels;
+            std::vector<Subscriber> subscribers;
+            std::vector<std::shared_ptr<const void>> owners;
         };
 
         /**
          * @brief 回调信息
          */
-        struct CallInfo {
-            std::unique_ptr<CallBase> call;
+        struct Entry {
+            uint32_t type;
+            Topic topic;
             size_t id;
+            Invoke invoke;
+            std::shared_ptr<const void> call;
+        };
+
+        /**
+         * @brief 合并方式信息
+         */
+        struct Policy {
+            uint32_t type;
+            Topic topic;
+            Coalesce coalesce;
+            Merge merge;
+            std::shared_ptr<const void> call;
         };
 
+        /**
+         * @brief 发布期间的读者计数
+         * @details 最后一个读者离开且有待释放的快照时负责回收
+         */
+        struct ReadGuard {
+            const EventBus& bus;
+            explicit ReadGuard(const EventBus& owner): bus(owner) { bus._readers.fetch_add(1); }
+            ~ReadGuard() {
+                if (bus._readers.fetch_sub(1) == 1 && bus._retiredPending.load()) bus.reclaim();
+            }
+        };
+
+        /**
+         * @brief 队列槽位
+         * @details sequence 等于入队位置时可写, 等于位置 + 1 时可读[Vyukov 有界队列]; 一个槽位占一条缓存行
+         */
+        struct alignas(64) QueueSlot {
+            std::atomic<size_t> sequence;
+            Topic topic;
+            Deliver deliver;
+            uint32_t type;
+            alignas(std::max_align_t) std::byte content[queueEventSize];
+        };
 
-        mutable std::map<std::type_index, std::map<std::string, std::vector<CallInfo>>> _subscriptionMap;
+        /**
+         * @brief dispatch 中等待合并结束的事件
+         */
+        struct Pending {
+            const Channel* channel;
+            Topic topic;
+            Deliver deliver;
+            alignas(std::max_align_t) std::byte content[queueEventSize];
+        };
+
+        mutable std::atomic<const Table*> _table{nullptr};
+        mutable std::atomic<size_t> _readers{0};
+        mutable std::mutex _mutex;
+        mutable std::vector<Entry> _entries;
+        mutable std::vector<Policy> _policies;
+        mutable std::vector<std::unique_ptr<const Table>> _retired;
+        mutable std::atomic<bool> _retiredPending{false};
         mutable size_t _idCounter{};
 
+        std::unique_ptr<QueueSlot[]> _queue;
+        size_t _queueMask{};
+        alignas(64) mutable std::atomic<size_t> _enqueuePosition{0};
+        alignas(64) mutable size_t _dequeuePosition{0};
+        mutable std::vector<Pending> _pending;     // 仅消费者线程访问, 容量在各次 dispatch 间复用
+
+        inline static std::atomic<uint32_t> _typeCounter{0};
+
+        /**
+         * @brief 事件类型编号
+         * @details 每个类型首次使用时分配, 代替 type_index 作为键
+         */
+        template<typename EventType>
+        static uint32_t typeId() {
+            static const uint32_t id = _typeCounter.fetch_add(1);
+            return id;
+        }
+
+        template<typename EventType>
+        static void invoke(const void* call, void* content) {
+            (*static_cast<const std::function<void(EventType&)>*>(call))(*static_cast<EventType*>(content));
+        }
+
+        template<typename EventType>
+        static void deliver(const EventBus& bus, Topic identifier, void* content) {
+            bus.publish(identifier, *std::launder(reinterpret_cast<EventType*>(content)));
+        }
+
+        template<typename EventType>
+        static void mergeInvoke(const void* call, void* merged, const void* next) {
+            (*static_cast<const std::function<void(EventType&, const EventType&)>*>(call))(
+                *std::launder(reinterpret_cast<EventType*>(merged)), *std::launder(reinterpret_cast<const EventType*>(next)));
+        }
+
+        static bool channelLess(const Channel& a, const Channel& b) {
+            return a.topic != b.topic ? a.topic < b.topic : a.type < b.type;
+        }
+
+        static const Channel* find(const Table& table, uint32_t type, Topic identifier) {
+            const Channel key{type, identifier, 0, 0};
+            const auto it = std::lower_bound(table.channels.begin(), table.channels.end(), key, channelLess);
+            if (it == table.channels.end() || it->type != type || it->topic != identifier) return nullptr;
+            return &*it;
+        }
+
+        /**
+         * @brief 把排队事件并入同分组的待发事件
+         * @details 待发事件通常只有几个, 线性查找
+         */
+        void merge(const Channel& channel, QueueSlot& slot) const {
+            for (auto& pending : _pending) {
+                if (pending.channel != &channel) continue;
+                if (channel.coalesce == Coalesce::Accumulate) {
+                    channel.merge(channel.mergeCall, pending.content, slot.content);
+                } else {
+                    std::memcpy(pending.content, slot.content, queueEventSize);
+                }
+                return;
+            }
+            auto& pending = _pending.emplace_back(Pending{&channel, slot.topic, slot.deliver, {}});
+            std::memcpy(pending.content, slot.content, queueEventSize);
+        }
+
+        /**
+         * @brief 释放替换下的快照
+         * @details 由最后离开的读者调用; 只尝试加锁, 锁被占用时持锁方替换快照后会自行检查,
+         * 仍未释放的快照留给下一个离开的读者, 发布路径因此不会阻塞
+         */
+        void reclaim() const {
+            const std::unique_lock lock{_mutex, std::try_to_lock};
+            if (!lock.owns_lock() || _readers.load() != 0) return;
+            _retired.clear();
+            _retiredPending.store(false);
+        }
+
+        /**
+         * @brief 由回调信息重建快照并替换
+         * @details 调用方持有锁; 替换后读者计数为 0 时, 此前替换下的快照都已无人读取, 一并释放;
+         * 否则标记待释放, 由最后离开的读者回收
+         */
+        void rebuild() const {
+            auto table = std::make_unique<Table>();
+            std::vector<const Entry*> order;
+            order.reserve(_entries.size());
+            for (const auto& e : _entries) order.push_back(&e);
+            std::stable_sort(order.begin(), order.end(), [](const Entry* a, const Entry* b) {
+                return channelLess(Channel{a->type, a->topic, 0, 0}, Channel{b->type, b->topic, 0, 0});
+            });
+
+            table->subscribers.reserve(order.size());
+            table->owners.reserve(order.size());
+            for (const Entry* e : order) {
+                if (table->channels.empty() || table->channels.back().type != e->type || table->channels.back().topic != e->topic) {
+                    table->channels.push_back(Channel{e->type, e->topic, static_cast<uint32_t>(table->subscribers.size()), 0});
+                }
+                table->channels.back().count++;
+                table->subscribers.push_back(Subscriber{e->invoke, e->call.get()});
+                table->owners.push_back(e->call);
+            }
+            for (const auto& policy : _policies) {
+                const Channel key{policy.type, policy.topic, 0, 0};
+                auto it = std::lower_bound(table->channels.begin(), table->channels.end(), key, channelLess);
+                if (it == table->channels.end() || it->type != key.type || it->topic != key.topic) {
+                    it = table->channels.insert(it, key);
+                }
+                it->coalesce = policy.coalesce;
+                it->merge = policy.merge;
+                it->mergeCall = policy.call.get();
+                if (policy.call) table->owners.push_back(policy.call);
+            }
+
+            if (const Table* old = _table.exchange(table.release()); old != nullptr) {
+                _retired.emplace_back(old);
+            }
+            // 先标记再检查读者计数: 读者已全部离开时在此释放, 否则最后离开的读者必能看到标记
+            _retiredPending.store(true);
+            if (_readers.load() == 0) {
+                _retired.clear();
+                _retiredPending.store(false);
+            }
+        }
 };
@@ -20,32 +20,28 @@ enum class DefaultLevel {
 };
 
 struct DefaultInfo {
-    std::string timestamp;
+    // 记录时只取时钟, 时间戳字符串在格式化时生成[异步模式下位于后台线程]
+    std::chrono::system_clock::time_point time{std::chrono::system_clock::now()};
 
-    DefaultInfo() {
-        // 生成时间戳
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
+    [[nodiscard]] std::string timestamp() const {
+        auto time_t_now = std::chrono::system_clock::to_time_t(time);
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()
+            time.time_since_epoch()
         ) % 1000;
 
         std::ostringstream oss;
         oss << std::put_time(std::localtime(&time_t_now), "%Y-%m-%d %H:%M:%S")
             << "." << std::setfill('0') << std::setw(3) << ms.count();
-        timestamp = oss.str();
+        return oss.str();
     }
 };
 
 namespace globalLogger {
-    inline DefaultLevel _minLevel{DefaultLevel::Info};
-
-    /**
-     * @brief 级别过滤器
-     */
-    inline bool levelFilter(const Logger<DefaultLevel, DefaultInfo>::LogRecord& record) {
-        return static_cast<int>(record.level) >= static_cast<int>(_minLevel);
-    }
+    // 处理器只写入缓冲, flush 时一次写出; 处理器同一时刻只在一个线程执行, 无需加锁
+    inline std::string _consoleBuffer{};
+    inline std::string _fileBuffer{};
+    // 先于 glog 构造、后于其析构, 后台线程退出前写出剩余记录时文件仍有效
+    inline std::ofstream _logFile{"all.log"};
 
     /**
      * @brief 格式化器
@@ -58,7 +54,7 @@ namespace globalLogger {
             case DefaultLevel::Warn:  levelStr = "WARN";  break;
             case DefaultLevel::Error: levelStr = "ERROR"; break;
         }
-        return std::format("{} [{}] {}", record.additionInfo.timestamp, levelStr, record.message);
+        return std::format("{} [{}] {}", record.additionInfo.timestamp(), levelStr, record.message);
     }
 
     /**
@@ -96,35 +92,60 @@ namespace globalLogger {
             // Linux/Mac ANSI颜色
             switch (record.level) {
                 case DefaultLevel::Error:
-                    std::cout << "\033[1;31m" << str << "\033[0m" << std::endl;
+                    _consoleBuffer += "\033[1;31m";
                     break;
                 case DefaultLevel::Warn:
-                    std::cout << "\033[1;33m" << str << "\033[0m" << std::endl;
+                    _consoleBuffer += "\033[1;33m";
                     break;
                 case DefaultLevel::Info:
-                    std::cout << "\033[1;32m" << str << "\033[0m" << std::endl;
+                    _consoleBuffer += "\033[1;32m";
                     break;
                 case DefaultLevel::Debug:
-                    std::cout << "\033[36m" << str << "\033[0m" << std::endl;
+                    _consoleBuffer += "\033[36m";
                     break;
             }
+            _consoleBuffer += str;
+            _consoleBuffer += "\033[0m\n";
         #endif
     }
 
+    /**
+     * @brief 控制台写出
+     * @details Windows 下颜色需逐条切换, 处理器已直接输出
+     */
+    inline void consoleFlush() {
+        if (_consoleBuffer.empty()) return;
+        std::cout.write(_consoleBuffer.data(), static_cast<std::streamsize>(_consoleBuffer.size()));
+        std::cout.flush();
+        _consoleBuffer.clear();
+    }
+
     /**
      * @brief 文件处理器
      */
     inline void fileHandler(const Logger<DefaultLevel, DefaultInfo>::LogRecord& record, const std::string& str) {
-        static std::ofstream logFile("all.log");
-        if (logFile.is_open()) {
-            logFile << str << std::endl;
+        _fileBuffer += str;
+        _fileBuffer += '\n';
+    }
+
+    /**
+     * @brief 文件写出
+     */
+    inline void fileFlush() {
+        if (_logFile.is_open() && !_fileBuffer.empty()) {
+            _logFile.write(_fileBuffer.data(), static_cast<std::streamsize>(_fileBuffer.size()));
+            _logFile.flush();
         }
+        _fileBuffer.clear();
     }
 };
 
 inline Logger<DefaultLevel, DefaultInfo> glog = Logger<DefaultLevel, DefaultInfo>::builder()
-                .appendFilter(globalLogger::levelFilter)
+                .minLevel(DefaultLevel::Info)
                 .formatter(globalLogger::format)
-                .appendHandler(globalLogger::consoleHandler)
-                .appendHandler(globalLogger::fileHandler)
+                .appendHandler(globalLogger::consoleHandler, globalLogger::consoleFlush)
+                .appendHandler(globalLogger::fileHandler, globalLogger::fileFlush)
+                .async(4096, Logger<DefaultLevel, DefaultInfo>::Overflow::DropAndCount)
+                .syncLevel(DefaultLevel::Error)
+                .reportDropped(DefaultLevel::Warn)
                 .build();
\ No newline at end of file
@@ -1,15 +1,37 @@
 #pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <format>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <functional>
 #include <mutex>
 #include <queue>
 #include <string>
+#include <thread>
+#include <type_traits>
 
+/**
+ * @brief 编译期最低日志等级
+ * @details 按等级枚举的底层值比较, 更低的等级在模板接口中编译为空;
+ * 未定义时 Release[NDEBUG] 下为 1[移除 DefaultLevel::Debug], 否则为 0
+ */
+#ifndef LOGGER_COMPILE_LEVEL
+#ifdef NDEBUG
+#define LOGGER_COMPILE_LEVEL 1
+#else
+#define LOGGER_COMPILE_LEVEL 0
+#endif
+#endif
 
 /**
  * @brief 日志器本体
- * @details 他似乎不需要详细注释[划掉]
+ * @details 默认在调用线程同步处理; 配置 async 后调用线程只把记录移入无锁有界队列[多生产者单消费者],
+ * 由后台线程成批过滤、格式化并交给处理器, 每批结束时各处理器 flush 一次;
+ * 等级先于一切处理检查: 低于 LOGGER_COMPILE_LEVEL 的在编译期移除, 低于运行期最低等级的在构造记录前返回
  * @tparam LogLevelEnum 日志等级
  * @tparam AdditionInfo 日志记录附加信息
  */
@@ -18,12 +40,36 @@ class Logger {
     static_assert(std::is_enum_v<LogLevelEnum>, "错误: 日志器模板类型[ LogLevelEnum ]必须为枚举类型");
     static_assert(std::is_default_constructible_v<AdditionInfo>, "错误: 日志器模板类型[ AdditionInfo ]必须实现默认构造");
     public:
+        using Underlying = std::underlying_type_t<LogLevelEnum>;
+
         struct LogRecord {
             LogLevelEnum level;
             std::string message;
             AdditionInfo additionInfo;
         };
 
+        /**
+         * @brief 异步队列已满时的处理方式
+         */
+        enum class Overflow {
+            Block,          // 等待后台线程腾出位置
+            Drop,           // 丢弃
+            DropAndCount    // 丢弃并计数, 见 dropped()
+        };
+
+        /**
+         * @brief 异步配置
+         * @details capacity 为 0 时同步处理
+         */
+        struct AsyncConfig {
+            size_t capacity{0};
+            Overflow overflow{Overflow::Block};
+            bool sync{false};
+            LogLevelEnum syncLevel{};
+            bool reportDropped{false};
+            LogLevelEnum droppedLevel{};
+        };
+
         /**
          * @brief 日志过滤器基类 | 过滤器包装器
          * @details 他似乎不需要详细注释[划掉]
@@ -82,10 +128,16 @@ class Logger {
         class BaseHandler {
             public:
                 using HandlerType = std::function<void(const LogRecord&, const std::string&)>;
+                using FlushType = std::function<void()>;
                 BaseHandler() = default;
 
                 template<typename Func, typename = std::enable_if_t<!std::is_base_of_v<BaseHandler, std::decay_t<Func>>>>
                 BaseHandler(Func&& handler): _handlerFunc(std::forward<Func>(handler)) {};
+
+                template<typename Func, typename Flush>
+                BaseHandler(Func&& handler, Flush&& flush):
+                    _handlerFunc(std::forward<Func>(handler)),
+                    _flushFunc(std::forward<Flush>(flush)) {};
                 virtual ~BaseHandler() = default;
                 BaseHandler(const BaseHandler&) = delete;
                 BaseHandler(BaseHandler&&) = default;
@@ -99,8 +151,19 @@ class Logger {
                     }
                 }
 
+                /**
+                 * @brief 写出缓冲的输出
+                 * @details 同步模式每条记录后调用, 异步模式每批记录后调用一次
+                 */
+                virtual void flush() {
+                    if (_flushFunc != nullptr) {
+                        _flushFunc();
+                    }
+                }
+
             private:
                 HandlerType _handlerFunc{};
+                FlushType _flushFunc{};
         };
 
 
@@ -164,13 +227,76 @@ class Logger {
                     return *this;
                 }
 
+                /**
+                 * @brief 配置添加带缓冲的日志处理器
+                 * @details handler 只写入缓冲, flush 时统一写出
+                 * @tparam Func 处理器类型
+                 * @tparam Flush 写出函数类型
+                 * @param handler 处理器
+                 * @param flush 写出函数
+                 * @return 构建者引用
+                 */
+                template<typename Func, typename Flush>
+                LoggerBuilder& appendHandler(Func&& handler, Flush&& flush) {
+                    handlers.emplace_back(std::make_unique<BaseHandler>(std::forward<Func>(handler), std::forward<Flush>(flush)));
+                    return *this;
+                }
+
+                /**
+                 * @brief 配置异步处理
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @param capacity 队列容量[向上取 2 的幂]
+                 * @param overflow 队列已满时的处理方式
+                 * @return 构建者引用
+                 */
+                LoggerBuilder& async(size_t capacity = 4096, Overflow overflow = Overflow::Block) {
+                    _async.capacity = capacity;
+                    _async.overflow = overflow;
+                    return *this;
+                }
+
+                /**
+                 * @brief 配置同步等级
+                 * @details 异步模式下不低于该等级的记录会等待其及之前的记录全部写出后才返回, 随后终止程序也不会丢失
+                 * @param level 日志等级
+                 * @return 构建者引用
+                 */
+                LoggerBuilder& syncLevel(LogLevelEnum level) {
+                    _async.sync = true;
+                    _async.syncLevel = level;
+                    return *this;
+                }
+
+                /**
+                 * @brief 配置丢弃报告
+                 * @details Overflow::DropAndCount 下, flush 与析构时把尚未报告的丢弃数以该等级记录一条
+                 * @param level 日志等级
+                 * @return 构建者引用
+                 */
+                LoggerBuilder& reportDropped(LogLevelEnum level) {
+                    _async.reportDropped = true;
+                    _async.droppedLevel = level;
+                    return *this;
+                }
+
+                /**
+                 * @brief 配置运行期最低日志等级
+                 * @details 低于该等级的记录不构造、不过滤、不格式化
+                 * @param level 日志等级
+                 * @return 构建者引用
+                 */
+                LoggerBuilder& minLevel(LogLevelEnum level) {
+                    _minLevel = static_cast<Underlying>(level);
+                    return *this;
+                }
+
                 /**
                  * @brief 构建日志器
                  * @details 他似乎不需要详细注释[划掉]
                  * @return 日志器
                  */
                 Logger build() {
-                    return Logger(std::move(filters), std::move(_formatter), std::move(handlers));
+                    return Logger(std::move(filters), std::move(_formatter), std::move(handlers), _async, _minLevel);
                 }
 
             private:
@@ -179,11 +305,19 @@ class Logger {
                 std::vector<std::unique_ptr<BaseHandler>> handlers;
 
                 std::queue<LogRecord> _logQueue;
-
+                AsyncConfig _async{};
+                Underlying _minLevel{std::numeric_limits<Underlying>::lowest()};
 
         };
 
-        ~Logger() = default;
+        ~Logger() {
+            if (_worker.joinable()) {
+                reportDropped();
+                _running.store(false);
+                wake();
+                _worker.join();
+            }
+        }
 
         /**
          * @brief 获取构建器
@@ -201,13 +335,32 @@ class Logger {
          * @param message 日志消息
          * @param info 日志附加信息
          */
-        void log(LogLevelEnum level, const std::string& message, AdditionInfo info = {}) {
-            {
+        void log(LogLevelEnum level, std::string message, AdditionInfo info) {
+            if (!enabled(level)) return;
+            if (_queue == nullptr) {
                 std::lock_guard lock(mtx);
-                processRecord(LogRecord{level, message, info});
+                processRecord(LogRecord{level, std::move(message), std::move(info)});
+                flushHandlers();
+                return;
+            }
+            const bool sync = _async.sync && static_cast<Underlying>(level) >= static_cast<Underlying>(_async.syncLevel);
+            const size_t position = enqueue(LogRecord{level, std::move(message), std::move(info)}, sync ? Overflow::Block : _async.overflow);
+            if (sync && position != invalidPosition) {
+                waitProcessed(position + 1);
             }
         }
 
+        /**
+         * @brief 添加日志
+         * @details 附加信息在等级通过后才构造
+         * @param level 日志等级
+         * @param message 日志消息
+         */
+        void log(LogLevelEnum level, std::string message) {
+            if (!enabled(level)) return;
+            log(level, std::move(message), AdditionInfo{});
+        }
+
         /**
          * @brief 添加日志[模板]
          * @details 他似乎不需要详细注释[划掉]
@@ -216,8 +369,84 @@ class Logger {
          * @param info 日志附加信息
          */
         template<LogLevelEnum Level>
-        void log(const std::string& message, AdditionInfo info = {}) {
-            log(Level, message, info);
+        void log(std::string message, AdditionInfo info) {
+            if constexpr (compiled(Level)) {
+                log(Level, std::move(message), std::move(info));
+            }
+        }
+
+        /**
+         * @brief 添加日志[模板]
+         * @details 消息在等级通过后才转换为 std::string, 附加信息随后构造
+         * @tparam Level 日志等级
+         * @tparam Message 可构造 std::string 的消息类型
+         * @param message 日志消息
+         */
+        template<LogLevelEnum Level, typename Message>
+        void log(Message&& message) {
+            if constexpr (compiled(Level)) {
+                if (!enabled(Level)) return;
+                log(Level, std::string(std::forward<Message>(message)), AdditionInfo{});
+            }
+        }
+
+        /**
+         * @brief 添加日志[延迟格式化]
+         * @details 参数以引用捕获, 等级通过后才格式化; 被编译期移除的等级连同格式化一并消失, 适合热路径
+         * @tparam Level 日志等级
+         * @tparam Args 参数类型
+         * @param format 格式字符串
+         * @param args 格式参数
+         */
+        template<LogLevelEnum Level, typename... Args>
+        void logf(std::format_string<Args...> format, Args&&... args) {
+            if constexpr (compiled(Level)) {
+                if (!enabled(Level)) return;
+                log(Level, std::format(format, std::forward<Args>(args)...), AdditionInfo{});
+            }
+        }
+
+        /**
+         * @brief 等级是否在编译期保留
+         * @details 他似乎不需要详细注释[划掉]
+         * @param level 日志等级
+         * @return 是否保留
+         */
+        static constexpr bool compiled(LogLevelEnum level) {
+            return static_cast<Underlying>(level) >= LOGGER_COMPILE_LEVEL;
+        }
+
+        /**
+         * @brief 等级是否会被记录
+         * @details 只比较等级, 过滤器仍可能拒绝
+         * @param level 日志等级
+         * @return 是否记录
+         */
+        [[nodiscard]] bool enabled(LogLevelEnum level) const {
+            return compiled(level) && static_cast<Underlying>(level) >= _minLevel.load(std::memory_order_relaxed);
+        }
+
+        void setMinLevel(LogLevelEnum level) {
+            _minLevel.store(static_cast<Underlying>(level), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 等待已提交的记录全部写出
+         * @details 同步模式下直接返回; 配置了丢弃报告时先记录尚未报告的丢弃数
+         */
+        void flush() {
+            if (_queue == nullptr) return;
+            reportDropped();
+            waitProcessed(_enqueuePosition.load());
+        }
+
+        /**
+         * @brief 因队列已满丢弃的记录数
+         * @details 仅 Overflow::DropAndCount 计数
+         * @return 数量
+         */
+        [[nodiscard]] size_t dropped() const {
+            return _dropped.load(std::memory_order_relaxed);
         }
 
         void processRecord(const LogRecord& record) {
@@ -231,25 +460,183 @@ class Logger {
         }
 
     private:
+        static constexpr size_t invalidPosition{~size_t{0}};
+
+        /**
+         * @brief 队列槽位
+         * @details sequence 等于入队位置时可写, 等于位置 + 1 时可读[Vyukov 有界队列]
+         */
+        struct Slot {
+            std::atomic<size_t> sequence;
+            LogRecord record;
+        };
+
         std::unique_ptr<BaseFormatter> _formatter;
         std::vector<std::unique_ptr<BaseFilter>> _filters;
         std::vector<std::unique_ptr<BaseHandler>> _handlers;
 
         std::mutex mtx;
 
+        AsyncConfig _async;
+        std::atomic<Underlying> _minLevel;
+        std::unique_ptr<Slot[]> _queue;
+        size_t _mask{0};
+        std::atomic<size_t> _enqueuePosition{0};
+        size_t _dequeuePosition{0};                 // 仅后台线程访问
+        std::atomic<size_t> _processed{0};          // 已写出的记录数
+        std::atomic<size_t> _dropped{0};
+        std::atomic<size_t> _reported{0};           // 已报告的丢弃数
+        std::atomic<uint32_t> _signal{0};
+        std::atomic<bool> _sleeping{false};
+        std::atomic<bool> _running{true};
+        std::thread _worker;
+
+        void flushHandlers() {
+            for (auto& e : _handlers) {
+                e->flush();
+            }
+        }
+
+        /**
+         * @brief 记录尚未报告的丢弃数
+         * @details 报告本身以 Overflow::Block 入队, 不会再被丢弃; 多个线程同时调用时每条丢弃只报告一次
+         */
+        void reportDropped() {
+            if (!_async.reportDropped || !enabled(_async.droppedLevel)) return;
+            const size_t dropped = _dropped.load(std::memory_order_relaxed);
+            size_t reported = _reported.load(std::memory_order_relaxed);
+            while (reported < dropped && !_reported.compare_exchange_weak(reported, dropped, std::memory_order_relaxed)) {}
+            if (reported >= dropped) return;
+            enqueue(LogRecord{_async.droppedLevel, std::format("日志队列已满, 已丢弃 {} 条记录", dropped - reported), AdditionInfo{}}, Overflow::Block);
+        }
+
+        [[nodiscard]] bool onWorker() const {
+            return std::this_thread::get_id() == _worker.get_id();
+        }
+
+        void wake() {
+            _signal.fetch_add(1);
+            _signal.notify_one();
+        }
+
+        /**
+         * @brief 记录入队
+         * @details 无锁; 后台线程自身记录日志时不会阻塞等待自己
+         * @param record 日志记录
+         * @param overflow 队列已满时的处理方式
+         * @return 入队位置[丢弃时为 invalidPosition]
+         */
+        size_t enqueue(LogRecord&& record, Overflow overflow) {
+            size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+            Slot* slot{nullptr};
+            for (;;) {
+                slot = &_queue[position & _mask];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+                if (difference == 0) {
+                    if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    if (overflow == Overflow::Block && !onWorker()) {
+                        std::this_thread::yield();
+                        position = _enqueuePosition.load(std::memory_order_relaxed);
+                        continue;
+                    }
+                    if (overflow == Overflow::DropAndCount) {
+                        _dropped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return invalidPosition;
+                } else {
+                    position = _enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            slot->record = std::move(record);
+            // 与后台线程的 _sleeping 构成先写后读的配对, 两边都用顺序一致, 保证至少一方看到对方
+            slot->sequence.store(position + 1);
+            if (_sleeping.load()) {
+                wake();
+            }
+            return position;
+        }
+
+        /**
+         * @brief 等待写出的记录数达到 count
+         * @details 后台线程自身调用时直接返回
+         */
+        void waitProcessed(size_t count) {
+            if (onWorker()) return;
+            for (size_t processed = _processed.load(); processed < count; processed = _processed.load()) {
+                _processed.wait(processed);
+            }
+        }
+
+        /**
+         * @brief 后台线程
+         * @details 每轮取出当前全部记录[至多队列容量]成批处理; 队列为空时休眠, 析构时处理完剩余记录再退出
+         */
+        void run() {
+            std::vector<LogRecord> batch;
+            batch.reserve(_mask + 1);
+            for (;;) {
+                const uint32_t signal = _signal.load();
+                while (batch.size() <= _mask) {
+                    Slot& slot = _queue[_dequeuePosition & _mask];
+                    if (slot.sequence.load() != _dequeuePosition + 1) break;
+                    batch.push_back(std::move(slot.record));
+                    slot.sequence.store(_dequeuePosition + _mask + 1, std::memory_order_release);
+                    _dequeuePosition++;
+                }
+                if (!batch.empty()) {
+                    {
+                        std::lock_guard lock(mtx);
+                        for (const auto& record : batch) {
+                            processRecord(record);
+                        }
+                        flushHandlers();
+                    }
+                    batch.clear();
+                    _processed.store(_dequeuePosition);
+                    _processed.notify_all();
+                    continue;
+                }
+                if (!_running.load()) break;
+                _sleeping.store(true);
+                if (_queue[_dequeuePosition & _mask].sequence.load() == _dequeuePosition + 1 || !_running.load()) {
+                    _sleeping.store(false);
+                    continue;
+                }
+                _signal.wait(signal);
+                _sleeping.store(false);
+            }
+        }
+
         /**
          * @brief 构建者使用的日志器构造
          * @details 他似乎不需要详细注释[划掉]
          * @param filters 过滤器数组
          * @param formatter 格式化器
          * @param handlers 处理器数组
+         * @param async 异步配置
+         * @param minLevel 运行期最低等级
          */
         Logger(std::vector<std::unique_ptr<BaseFilter>> filters,
            std::unique_ptr<BaseFormatter> formatter,
-           std::vector<std::unique_ptr<BaseHandler>> handlers):
+           std::vector<std::unique_ptr<BaseHandler>> handlers,
+           AsyncConfig async,
+           Underlying minLevel):
                 _filters(std::move(filters)),
                 _formatter(std::move(formatter)),
-                _handlers(std::move(handlers)){
+                _handlers(std::move(handlers)),
+                _async(async),
+                _minLevel(minLevel){
+        if (_async.capacity == 0) return;
+        size_t capacity{2};
+        while (capacity < _async.capacity) capacity <<= 1;
+        _queue = std::make_unique<Slot[]>(capacity);
+        _mask = capacity - 1;
+        for (size_t i = 0; i < capacity; i++) {
+            _queue[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        _worker = std::thread([this] { run(); });
     }
 };
 
@@ -0,0 +1,388 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+
+#include <GlobalLogger.hpp>
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Forsyth 打分参数
+     */
+    constexpr size_t modelCacheSize = 32;
+    constexpr size_t maxValence = 32;
+    constexpr float cacheDecayPower = 1.5f;
+    constexpr float lastTriangleScore = 0.75f;
+    constexpr float valenceBoostScale = 2.0f;
+    constexpr float valenceBoostPower = 0.5f;
+
+    /**
+     * @brief 预先计算的顶点分数表
+     */
+    struct ScoreTable {
+        float cache[modelCacheSize]{};
+        float valence[maxValence + 1]{};
+
+        ScoreTable() {
+            for (size_t i = 0; i < modelCacheSize; i++) {
+                // 最近一个三角形的 3 个顶点给固定分数, 避免反复选择同一条带
+                cache[i] = i < 3 ? lastTriangleScore
+                    : pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(modelCacheSize - 3), cacheDecayPower);
+            }
+            for (size_t i = 1; i <= maxValence; i++) {
+                valence[i] = valenceBoostScale * pow(static_cast<float>(i), -valenceBoostPower);
+            }
+        }
+
+        [[nodiscard]] float score(const int cachePosition, const unsigned int liveTriangles) const {
+            if (liveTriangles == 0) return -1.0f;
+            const float base = cachePosition < 0 ? 0.0f : cache[cachePosition];
+            return base + valence[min<size_t>(liveTriangles, maxValence)];
+        }
+    };
+
+    bool validTriangles(const vector<unsigned int>& indices, const size_t vertexCount) {
+        if (indices.size() % 3 != 0) {
+            glog.log<DefaultLevel::Warn>("错误: 网格优化要求三角形列表索引, 索引数不是 3 的倍数");
+            return false;
+        }
+        if (any_of(indices.begin(), indices.end(), [&](const unsigned int e) { return e >= vertexCount; })) {
+            glog.log<DefaultLevel::Warn>("错误: 网格优化的索引超出顶点数量");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 以时间戳模拟的 FIFO 缓存
+     * @details 与 analyzeVertexCache 相同的模型, reset 使全部顶点失效
+     */
+    class FifoCache {
+        public:
+            FifoCache(const size_t vertexCount, const size_t cacheSize):
+                _timestamp(vertexCount, 0),
+                _time(cacheSize + 1),
+                _size(cacheSize) {}
+
+            unsigned int misses(const unsigned int* triangle) {
+                unsigned int out{0};
+                for (size_t k = 0; k < 3; k++) {
+                    if (_time - _timestamp[triangle[k]] > _size) {
+                        _timestamp[triangle[k]] = _time++;
+                        out++;
+                    }
+                }
+                return out;
+            }
+
+            void reset() {
+                _time += _size + 1;
+            }
+
+        private:
+            vector<size_t> _timestamp;
+            size_t _time;
+            size_t _size;
+    };
+
+    const VertexLayout<float>::LayoutElement* positionElement(const VertexLayout<float>& layout) {
+        const auto& elements = layout.elements();
+        const auto it = find_if(elements.begin(), elements.end(), [](const auto& e) {
+            return e.identifier == "vertices" && e.length >= 3;
+        });
+        return it == elements.end() ? nullptr : &*it;
+    }
+}
+
+MeshOptimizer::CacheStatistics MeshOptimizer::analyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount, size_t cacheSize) {
+    CacheStatistics out{};
+    out.triangles = indices.size() / 3;
+    if (indices.empty() || cacheSize == 0) return out;
+
+    // 记录顶点进入缓存时的时间戳, 距今不超过 cacheSize 即视为命中, 等价于 FIFO
+    vector<size_t> timestamp(vertexCount, 0);
+    size_t time{cacheSize + 1};
+    vector<bool> used(vertexCount, false);
+    for (const unsigned int e : indices) {
+        if (e >= vertexCount) continue;
+        if (!used[e]) {
+            used[e] = true;
+            out.vertices++;
+        }
+        if (time - timestamp[e] > cacheSize) {
+            timestamp[e] = time++;
+            out.transforms++;
+        }
+    }
+    out.acmr = out.triangles == 0 ? 0.0f : static_cast<float>(out.transforms) / static_cast<float>(out.triangles);
+    out.atvr = out.vertices == 0 ? 0.0f : static_cast<float>(out.transforms) / static_cast<float>(out.vertices);
+    return out;
+}
+
+std::vector<unsigned int> MeshOptimizer::vertexCacheOrder(const std::vector<unsigned int> &indices, size_t vertexCount) {
+    if (!validTriangles(indices, vertexCount)) return {};
+    static const ScoreTable table{};
+    const size_t triangleCount = indices.size() / 3;
+
+    // 顶点 -> 相邻三角形[CSR], liveTriangles 为尚未输出的相邻三角形数
+    vector<unsigned int> liveTriangles(vertexCount, 0);
+    for (const unsigned int e : indices) {
+        liveTriangles[e]++;
+    }
+    vector<unsigned int> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t i = 0; i < vertexCount; i++) {
+        adjacencyOffset[i + 1] = adjacencyOffset[i] + liveTriangles[i];
+    }
+    vector<unsigned int> adjacency(indices.size());
+    {
+        vector<unsigned int> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++) {
+            adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+    }
+
+    vector<float> vertexScore(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++) {
+        vertexScore[i] = table.score(-1, liveTriangles[i]);
+    }
+    vector<bool> emitted(triangleCount, false);
+    vector<unsigned int> order{};
+    order.reserve(triangleCount);
+    // 额外 3 项容纳新三角形挤出的顶点
+    unsigned int cache[modelCacheSize + 3];
+    unsigned int cacheNext[modelCacheSize + 3];
+    size_t cacheCount{0};
+    size_t cursor{0};
+    size_t best{triangleCount};
+
+    while (true) {
+        if (best == triangleCount) {
+            // 无候选时按输入顺序取下一个未输出的三角形
+            while (cursor < triangleCount && emitted[cursor]) cursor++;
+            if (cursor == triangleCount) break;
+            best = cursor;
+        }
+        order.push_back(static_cast<unsigned int>(best));
+        emitted[best] = true;
+        const unsigned int* triangle = indices.data() + best * 3;
+
+        // 新三角形的顶点移至缓存前端, 其余顶点依次后移
+        size_t nextCount{0};
+        for (size_t k = 0; k < 3; k++) {
+            const unsigned int v = triangle[k];
+            cacheNext[nextCount++] = v;
+            // 从相邻列表中移除已输出的三角形
+            auto* begin = adjacency.data() + adjacencyOffset[v];
+            auto* end = begin + liveTriangles[v];
+            auto* it = find(begin, end, static_cast<unsigned int>(best));
+            if (it != end) {
+                *it = *(end - 1);
+                liveTriangles[v]--;
+            }
+        }
+        for (size_t i = 0; i < cacheCount; i++) {
+            const unsigned int v = cache[i];
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                cacheNext[nextCount++] = v;
+            }
+        }
+        for (size_t i = modelCacheSize; i < nextCount; i++) {
+            vertexScore[cacheNext[i]] = table.score(-1, liveTriangles[cacheNext[i]]);
+        }
+        cacheCount = min(nextCount, modelCacheSize);
+        copy_n(cacheNext, cacheCount, cache);
+
+        // 仅更新缓存内顶点及其相邻三角形的分数, 同时挑选下一个三角形
+        for (size_t i = 0; i < cacheCount; i++) {
+            vertexScore[cache[i]] = table.score(static_cast<int>(i), liveTriangles[cache[i]]);
+        }
+        best = triangleCount;
+        float bestScore{-1.0f};
+        for (size_t i = 0; i < cacheCount; i++) {
+            const unsigned int v = cache[i];
+            const unsigned int* begin = adjacency.data() + adjacencyOffset[v];
+            for (const unsigned int* it = begin; it != begin + liveTriangles[v]; it++) {
+                const unsigned int* t = indices.data() + size_t{*it} * 3;
+                const float score = vertexScore[t[0]] + vertexScore[t[1]] + vertexScore[t[2]];
+                // 同分时取序号较小者, 保证结果与相邻列表的内部顺序无关
+                if (score > bestScore || (score == bestScore && *it < best)) {
+                    bestScore = score;
+                    best = *it;
+                }
+            }
+        }
+    }
+    return order;
+}
+
+std::vector<unsigned int> MeshOptimizer::optimizeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount) {
+    const vector<unsigned int> order = vertexCacheOrder(indices, vertexCount);
+    if (order.size() * 3 != indices.size()) return indices;
+    vector<unsigned int> out(indices.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        copy_n(indices.data() + size_t{order[i]} * 3, 3, out.data() + i * 3);
+    }
+    return out;
+}
+
+std::vector<unsigned int> MeshOptimizer::overdrawOrder(const std::vector<unsigned int> &indices, const float *positions, size_t vertexCount, size_t stride,
+    float threshold, size_t cacheSize) {
+    if (!validTriangles(indices, vertexCount) || stride < 3) return {};
+    const size_t triangleCount = indices.size() / 3;
+    cacheSize = max<size_t>(cacheSize, 3);
+
+    // 硬簇: 三个顶点全部未命中说明缓存已整体换出, 从此处开始的簇与之前的簇没有共享顶点
+    vector<size_t> hard{};
+    {
+        FifoCache cache(vertexCount, cacheSize);
+        for (size_t t = 0; t < triangleCount; t++) {
+            if (cache.misses(indices.data() + t * 3) == 3 || t == 0) hard.push_back(t);
+        }
+        hard.push_back(triangleCount);
+    }
+
+    // 软簇: 在硬簇内从空缓存开始累计, 累计 ACMR 降到阈值以下时切分, 切分处的缓存失效代价不超过阈值
+    vector<size_t> clusters{};
+    FifoCache cache(vertexCount, cacheSize);
+    for (size_t h = 0; h + 1 < hard.size(); h++) {
+        const size_t begin = hard[h], end = hard[h + 1];
+        size_t misses{0};
+        cache.reset();
+        for (size_t t = begin; t < end; t++) {
+            misses += cache.misses(indices.data() + t * 3);
+        }
+        const float limit = threshold * static_cast<float>(misses) / static_cast<float>(end - begin);
+
+        cache.reset();
+        size_t start = begin;
+        misses = 0;
+        clusters.push_back(begin);
+        for (size_t t = begin; t + 1 < end; t++) {
+            misses += cache.misses(indices.data() + t * 3);
+            if (static_cast<float>(misses) / static_cast<float>(t + 1 - start) <= limit) {
+                clusters.push_back(t + 1);
+                cache.reset();
+                start = t + 1;
+                misses = 0;
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    auto position = [&](const unsigned int v) { return positions + size_t{v} * stride; };
+    double center[3]{};
+    for (size_t v = 0; v < vertexCount; v++) {
+        for (size_t k = 0; k < 3; k++) center[k] += position(static_cast<unsigned int>(v))[k];
+    }
+    for (double& e : center) e /= static_cast<double>(max<size_t>(vertexCount, 1));
+
+    // 簇中心按面积加权, 簇法线为各三角形叉积之和
+    const size_t clusterCount = clusters.size() - 1;
+    vector<float> keys(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) {
+        double centroid[3]{}, normal[3]{}, area{0.0};
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+            const float* a = position(indices[t * 3]);
+            const float* b = position(indices[t * 3 + 1]);
+            const float* d = position(indices[t * 3 + 2]);
+            const double u[3]{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            const double w[3]{d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+            const double n[3]{u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0]};
+            const double weight = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (size_t k = 0; k < 3; k++) {
+                centroid[k] += (a[k] + b[k] + d[k]) / 3.0 * weight;
+                normal[k] += n[k];
+            }
+            area += weight;
+        }
+        const double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (area <= 0.0 || length <= 0.0) continue;
+        double key{0.0};
+        for (size_t k = 0; k < 3; k++) {
+            key += (centroid[k] / area - center[k]) * normal[k] / length;
+        }
+        keys[c] = static_cast<float>(key);
+    }
+
+    vector<unsigned int> sorted(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) sorted[c] = static_cast<unsigned int>(c);
+    stable_sort(sorted.begin(), sorted.end(), [&](const unsigned int a, const unsigned int b) {
+        return keys[a] > keys[b];
+    });
+    vector<unsigned int> order{};
+    order.reserve(triangleCount);
+    for (const unsigned int c : sorted) {
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+            order.push_back(static_cast<unsigned int>(t));
+        }
+    }
+    return order;
+}
+
+std::vector<unsigned int> MeshOptimizer::optimizeOverdraw(const std::vector<unsigned int> &indices, const float *positions, size_t vertexCount, size_t stride,
+    float threshold) {
+    const vector<unsigned int> order = overdrawOrder(indices, positions, vertexCount, stride, threshold);
+    if (order.size() * 3 != indices.size()) return indices;
+    vector<unsigned int> out(indices.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        copy_n(indices.data() + size_t{order[i]} * 3, 3, out.data() + i * 3);
+    }
+    return out;
+}
+
+std::vector<unsigned int> MeshOptimizer::optimizeOverdraw(const std::vector<unsigned int> &indices, const VertexLayout<float> &layout, float threshold) {
+    const auto* position = positionElement(layout);
+    if (position == nullptr || layout.rawIndices().empty()) return indices;
+    const vector<float>& buffer = layout.WeldIndices();
+    const size_t stride = layout.elements()[0].step / sizeof(float);
+    return optimizeOverdraw(indices, buffer.data() + position->origin / sizeof(float), buffer.size() / stride, stride, threshold);
+}
+
+MeshOptimizer::Report MeshOptimizer::optimize(VertexLayout<float> &layout, size_t cacheSize, float overdrawThreshold) {
+    Report report{};
+    const auto& elements = layout.elements();
+    const auto& raw = layout.rawIndices();
+    if (elements.empty() || raw.empty()) return report;
+    const size_t elementCount = elements.size();
+    const size_t stride = elements[0].step / sizeof(float);
+    if (raw.size() % (elementCount * 3) != 0) {
+        glog.log<DefaultLevel::Warn>("错误: 网格优化要求三角形列表, 面角数不是 3 的倍数");
+        return report;
+    }
+
+    const size_t vertexCount = layout.WeldIndices().size() / stride;
+    const vector<unsigned int>& welded = layout.bufferOfIndices();
+    report.before = analyzeVertexCache(welded, vertexCount, cacheSize);
+    vector<unsigned int> order = vertexCacheOrder(welded, vertexCount);
+    if (order.size() * 3 * elementCount != raw.size()) {
+        report.after = report.before;
+        return report;
+    }
+    if (const auto* position = positionElement(layout); position != nullptr && overdrawThreshold > 0.0f) {
+        vector<unsigned int> cacheOrdered(welded.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            copy_n(welded.data() + size_t{order[i]} * 3, 3, cacheOrdered.data() + i * 3);
+        }
+        const vector<unsigned int> clustered = overdrawOrder(cacheOrdered, layout.WeldIndices().data() + position->origin / sizeof(float),
+            vertexCount, stride, overdrawThreshold, cacheSize);
+        if (clustered.size() == order.size()) {
+            vector<unsigned int> composed(order.size());
+            for (size_t i = 0; i < order.size(); i++) {
+                composed[i] = order[clustered[i]];
+            }
+            order = std::move(composed);
+        }
+    }
+
+    // 三角形在原始面角索引中占 3 * elementCount 个连续索引
+    const size_t triangleSize = elementCount * 3;
+    vector<unsigned int> reordered(raw.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        copy_n(raw.data() + size_t{order[i]} * triangleSize, triangleSize, reordered.data() + i * triangleSize);
+    }
+    layout.indices(std::move(reordered));
+    const size_t reweldedCount = layout.WeldIndices().size() / stride;
+    report.after = analyzeVertexCache(layout.bufferOfIndices(), reweldedCount, cacheSize);
+    return report;
+}
@@ -0,0 +1,339 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <GlobalLogger.hpp>
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief 对称 4x4 二次误差矩阵
+     * @details w 为累计的平面权重, 误差除以 w 即到各平面的加权均方距离
+     */
+    struct Quadric {
+        double a00, a01, a02, a11, a12, a22;
+        double b0, b1, b2;
+        double c;
+        double w;
+
+        Quadric& operator += (const Quadric& other) {
+            a00 += other.a00; a01 += other.a01; a02 += other.a02;
+            a11 += other.a11; a12 += other.a12; a22 += other.a22;
+            b0 += other.b0; b1 += other.b1; b2 += other.b2;
+            c += other.c;
+            w += other.w;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief 累加平面 n·p + d = 0 的二次误差
+     */
+    void addPlane(Quadric& q, const double* n, const double d, const double weight) {
+        q.a00 += weight * n[0] * n[0]; q.a01 += weight * n[0] * n[1]; q.a02 += weight * n[0] * n[2];
+        q.a11 += weight * n[1] * n[1]; q.a12 += weight * n[1] * n[2]; q.a22 += weight * n[2] * n[2];
+        q.b0 += weight * n[0] * d; q.b1 += weight * n[1] * d; q.b2 += weight * n[2] * d;
+        q.c += weight * d * d;
+        q.w += weight;
+    }
+
+    double evaluate(const Quadric& q, const float* p) {
+        const double x = p[0], y = p[1], z = p[2];
+        const double result = q.a00 * x * x + 2.0 * q.a01 * x * y + 2.0 * q.a02 * x * z
+            + q.a11 * y * y + 2.0 * q.a12 * y * z + q.a22 * z * z
+            + 2.0 * (q.b0 * x + q.b1 * y + q.b2 * z) + q.c;
+        return max(result, 0.0);
+    }
+
+    inline void cross(const double* a, const double* b, double* out) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    inline double normalize(double* v) {
+        const double length = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length > 0.0) {
+            v[0] /= length; v[1] /= length; v[2] /= length;
+        }
+        return length;
+    }
+
+    inline uint64_t edgeKey(const unsigned int a, const unsigned int b) {
+        return a < b ? (uint64_t{a} << 32) | b : (uint64_t{b} << 32) | a;
+    }
+
+    /**
+     * @brief 带所属三角形的边
+     */
+    struct Edge {
+        uint64_t key;
+        unsigned int triangle;
+
+        bool operator < (const Edge& other) const {
+            return key != other.key ? key < other.key : triangle < other.triangle;
+        }
+    };
+
+    /**
+     * @brief 候选折叠
+     * @details cost 含属性项, 用于排序; error 为仅由位置二次误差得到的距离
+     */
+    struct Collapse {
+        unsigned int from;
+        unsigned int to;
+        double cost;
+        double error;
+    };
+
+    inline bool degenerate(const unsigned int* t) {
+        return t[0] == t[1] || t[1] == t[2] || t[0] == t[2];
+    }
+}
+
+std::vector<unsigned int> MeshSimplifier::simplify(const std::vector<unsigned int> &indices, const float *vertices, size_t vertexCount, size_t stride,
+    size_t positionOffset, size_t targetIndexCount, const Options &options, float *resultError) {
+    if (resultError != nullptr) *resultError = 0.0f;
+    if (indices.size() % 3 != 0 || positionOffset + 3 > stride) {
+        glog.log<DefaultLevel::Warn>("错误: 网格简化要求三角形列表索引与包含位置的顶点");
+        return indices;
+    }
+    if (any_of(indices.begin(), indices.end(), [&](const unsigned int e) { return e >= vertexCount; })) {
+        glog.log<DefaultLevel::Warn>("错误: 网格简化的索引超出顶点数量");
+        return indices;
+    }
+    auto position = [&](const unsigned int v) { return vertices + size_t{v} * stride + positionOffset; };
+
+    vector<unsigned int> result = indices;
+    vector<Edge> edges{};
+    auto collectEdges = [&] {
+        edges.clear();
+        edges.reserve(result.size());
+        for (size_t t = 0; t < result.size() / 3; t++) {
+            const unsigned int* tri = result.data() + t * 3;
+            for (size_t k = 0; k < 3; k++) {
+                edges.push_back(Edge{edgeKey(tri[k], tri[(k + 1) % 3]), static_cast<unsigned int>(t)});
+            }
+        }
+        sort(edges.begin(), edges.end());
+    };
+    // 仅被一个三角形使用的边为边界边[开放边界或属性接缝]
+    auto isBorder = [&](const size_t i) {
+        return (i == 0 || edges[i - 1].key != edges[i].key) && (i + 1 == edges.size() || edges[i + 1].key != edges[i].key);
+    };
+
+    // 初始二次误差: 相邻三角形平面按面积加权
+    vector<Quadric> quadrics(vertexCount, Quadric{});
+    for (size_t t = 0; t < result.size() / 3; t++) {
+        const unsigned int* tri = result.data() + t * 3;
+        const float* p0 = position(tri[0]);
+        const float* p1 = position(tri[1]);
+        const float* p2 = position(tri[2]);
+        const double e1[3]{double{p1[0]} - p0[0], double{p1[1]} - p0[1], double{p1[2]} - p0[2]};
+        const double e2[3]{double{p2[0]} - p0[0], double{p2[1]} - p0[1], double{p2[2]} - p0[2]};
+        double n[3];
+        cross(e1, e2, n);
+        const double area = normalize(n) * 0.5;
+        if (area == 0.0) continue;
+        const double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+        for (size_t k = 0; k < 3; k++) {
+            addPlane(quadrics[tri[k]], n, d, area);
+        }
+    }
+    collectEdges();
+    if (!options.lockBorder) {
+        // 边界边额外加入垂直于所在三角形的约束平面, 使边界尽量保持形状
+        for (size_t i = 0; i < edges.size(); i++) {
+            if (!isBorder(i)) continue;
+            const auto a = static_cast<unsigned int>(edges[i].key >> 32);
+            const auto b = static_cast<unsigned int>(edges[i].key & 0xFFFFFFFFu);
+            const unsigned int* tri = result.data() + size_t{edges[i].triangle} * 3;
+            const float* p0 = position(tri[0]);
+            const float* p1 = position(tri[1]);
+            const float* p2 = position(tri[2]);
+            const double e1[3]{double{p1[0]} - p0[0], double{p1[1]} - p0[1], double{p1[2]} - p0[2]};
+            const double e2[3]{double{p2[0]} - p0[0], double{p2[1]} - p0[1], double{p2[2]} - p0[2]};
+            double n[3];
+            cross(e1, e2, n);
+            normalize(n);
+            const float* pa = position(a);
+            const float* pb = position(b);
+            double edge[3]{double{pb[0]} - pa[0], double{pb[1]} - pa[1], double{pb[2]} - pa[2]};
+            double plane[3];
+            cross(edge, n, plane);
+            const double length = normalize(edge);
+            if (normalize(plane) == 0.0) continue;
+            const double d = -(plane[0] * pa[0] + plane[1] * pa[1] + plane[2] * pa[2]);
+            addPlane(quadrics[a], plane, d, length * length);
+            addPlane(quadrics[b], plane, d, length * length);
+        }
+    }
+
+    double appliedError{0.0};
+    vector<uint8_t> border(vertexCount);
+    vector<uint8_t> touched(vertexCount);
+    vector<unsigned int> adjacencyOffset(vertexCount + 1);
+    vector<unsigned int> adjacency{};
+    vector<Collapse> collapses{};
+
+    while (result.size() > targetIndexCount) {
+        collectEdges();
+        fill(border.begin(), border.end(), 0);
+        for (size_t i = 0; i < edges.size(); i++) {
+            if (!isBorder(i)) continue;
+            border[edges[i].key >> 32] = 1;
+            border[edges[i].key & 0xFFFFFFFFu] = 1;
+        }
+
+        // 候选折叠: 每条边取允许方向中代价较小者
+        collapses.clear();
+        for (size_t i = 0; i < edges.size(); i++) {
+            if (i != 0 && edges[i - 1].key == edges[i].key) continue;
+            const bool borderEdge = isBorder(i);
+            const auto a = static_cast<unsigned int>(edges[i].key >> 32);
+            const auto b = static_cast<unsigned int>(edges[i].key & 0xFFFFFFFFu);
+            auto allowed = [&](const unsigned int from) {
+                return border[from] == 0 || (!options.lockBorder && borderEdge);
+            };
+            auto collapse = [&](const unsigned int from, const unsigned int to) {
+                Quadric q = quadrics[from];
+                q += quadrics[to];
+                double attribute{0.0};
+                const float* vf = vertices + size_t{from} * stride;
+                const float* vt = vertices + size_t{to} * stride;
+                for (size_t c = 0; c < stride; c++) {
+                    if (c >= positionOffset && c < positionOffset + 3) continue;
+                    attribute += double{vf[c] - vt[c]} * (vf[c] - vt[c]);
+                }
+                const double positional = evaluate(q, position(to));
+                return Collapse{from, to, positional + options.attributeWeight * attribute, q.w > 0.0 ? sqrt(positional / q.w) : 0.0};
+            };
+            const bool ab = allowed(a), ba = allowed(b);
+            if (!ab && !ba) continue;
+            const Collapse forward = ab ? collapse(a, b) : Collapse{a, b, numeric_limits<double>::max(), 0.0};
+            const Collapse backward = ba ? collapse(b, a) : Collapse{b, a, numeric_limits<double>::max(), 0.0};
+            collapses.push_back(forward.cost <= backward.cost ? forward : backward);
+        }
+        if (collapses.empty()) break;
+        sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) {
+            if (x.cost != y.cost) return x.cost < y.cost;
+            return x.from != y.from ? x.from < y.from : x.to < y.to;
+        });
+
+        // 顶点 -> 相邻三角形[CSR]
+        fill(adjacencyOffset.begin(), adjacencyOffset.end(), 0);
+        for (const unsigned int e : result) {
+            adjacencyOffset[e + 1]++;
+        }
+        for (size_t i = 0; i < vertexCount; i++) {
+            adjacencyOffset[i + 1] += adjacencyOffset[i];
+        }
+        adjacency.resize(result.size());
+        {
+            vector<unsigned int> cursor(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+            for (size_t i = 0; i < result.size(); i++) {
+                adjacency[cursor[result[i]]++] = static_cast<unsigned int>(i / 3);
+            }
+        }
+
+        fill(touched.begin(), touched.end(), 0);
+        const size_t needTriangles = (result.size() - targetIndexCount + 2) / 3;
+        size_t removed{0};
+        size_t applied{0};
+        for (const auto& c : collapses) {
+            if (removed >= needTriangles) break;
+            if (touched[c.from] || touched[c.to] || c.error > options.maxError) continue;
+
+            // 翻转检查: 不含折叠目标的相邻三角形在移动后法线不得反向
+            bool flipped{false};
+            size_t willRemove{0};
+            for (size_t j = adjacencyOffset[c.from]; j < adjacencyOffset[c.from + 1] && !flipped; j++) {
+                const unsigned int* tri = result.data() + size_t{adjacency[j]} * 3;
+                if (degenerate(tri)) continue;
+                if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                    willRemove++;
+                    continue;
+                }
+                const float* p[3]{position(tri[0]), position(tri[1]), position(tri[2])};
+                const float* moved[3]{p[0], p[1], p[2]};
+                for (size_t k = 0; k < 3; k++) {
+                    if (tri[k] == c.from) moved[k] = position(c.to);
+                }
+                double before[3], after[3];
+                {
+                    const double e1[3]{double{p[1][0]} - p[0][0], double{p[1][1]} - p[0][1], double{p[1][2]} - p[0][2]};
+                    const double e2[3]{double{p[2][0]} - p[0][0], double{p[2][1]} - p[0][1], double{p[2][2]} - p[0][2]};
+                    cross(e1, e2, before);
+                }
+                {
+                    const double e1[3]{double{moved[1][0]} - moved[0][0], double{moved[1][1]} - moved[0][1], double{moved[1][2]} - moved[0][2]};
+                    const double e2[3]{double{moved[2][0]} - moved[0][0], double{moved[2][1]} - moved[0][1], double{moved[2][2]} - moved[0][2]};
+                    cross(e1, e2, after);
+                }
+                flipped = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0;
+            }
+            if (flipped) continue;
+
+            for (size_t j = adjacencyOffset[c.from]; j < adjacencyOffset[c.from + 1]; j++) {
+                unsigned int* tri = result.data() + size_t{adjacency[j]} * 3;
+                for (size_t k = 0; k < 3; k++) {
+                    if (tri[k] == c.from) tri[k] = c.to;
+                }
+            }
+            quadrics[c.to] += quadrics[c.from];
+            touched[c.from] = touched[c.to] = 1;
+            removed += willRemove;
+            appliedError = max(appliedError, c.error);
+            applied++;
+        }
+        if (applied == 0) break;
+
+        // 移除退化三角形
+        size_t write{0};
+        for (size_t t = 0; t < result.size(); t += 3) {
+            if (degenerate(result.data() + t)) continue;
+            copy_n(result.data() + t, 3, result.data() + write);
+            write += 3;
+        }
+        result.resize(write);
+    }
+
+    if (resultError != nullptr) *resultError = static_cast<float>(appliedError);
+    return result;
+}
+
+std::vector<MeshSimplifier::Lod> MeshSimplifier::buildLodChain(const VertexLayout<float> &layout, const std::vector<float> &ratios, const Options &options) {
+    const auto& elements = layout.elements();
+    const auto position = find_if(elements.begin(), elements.end(), [](const auto& e) {
+        return e.identifier == "vertices" && e.length >= 3;
+    });
+    if (position == elements.end() || layout.rawIndices().empty()) {
+        glog.log<DefaultLevel::Warn>("错误: 细节层次生成需要 vertices 元素与索引");
+        return {};
+    }
+    const vector<float>& buffer = layout.WeldIndices();
+    const size_t stride = elements[0].step / sizeof(float);
+    const size_t vertexCount = buffer.size() / stride;
+    const size_t triangleCount = layout.bufferOfIndices().size() / 3;
+
+    vector<Lod> out{};
+    out.reserve(ratios.size());
+    const vector<unsigned int>* previous = &layout.bufferOfIndices();
+    float error{0.0f};
+    for (const float ratio : ratios) {
+        const auto target = static_cast<size_t>(static_cast<double>(triangleCount) * clamp(ratio, 0.0f, 1.0f)) * 3;
+        float levelError{0.0f};
+        auto indices = simplify(*previous, buffer.data(), vertexCount, stride, position->origin / sizeof(float), target, options, &levelError);
+        // 各级在上一级基础上简化, 二次误差只相对上一级, 累加各级误差作为相对原始网格的上界
+        error += levelError;
+        out.push_back(Lod{ratio, error, std::move(indices)});
+        previous = &out.back().indices;
+    }
+    return out;
+}
+
+std::vector<MeshSimplifier::Lod> MeshSimplifier::buildLodChain(const VertexLayout<float> &layout, const std::vector<float> &ratios) {
+    return buildLodChain(layout, ratios, Options{});
+}
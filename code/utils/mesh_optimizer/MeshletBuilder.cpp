@@ -0,0 +1,245 @@
+#include "MeshletBuilder.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include <GlobalLogger.hpp>
+
+using namespace std;
+
+namespace {
+    constexpr unsigned int invalidIndex = ~0u;
+
+    inline float distanceSquared(const float* a, const float* b) {
+        const float x = a[0] - b[0], y = a[1] - b[1], z = a[2] - b[2];
+        return x * x + y * y + z * z;
+    }
+
+    /**
+     * @brief Ritter 近似包围球
+     */
+    void boundingSphere(const MeshletBuilder::MeshletMesh& mesh, MeshletBuilder::Meshlet& meshlet, const float* positions, const size_t stride) {
+        const unsigned int* vertices = mesh.vertices.data() + meshlet.vertexOffset;
+        auto position = [&](const size_t i) { return positions + size_t{vertices[i]} * stride; };
+        auto farthest = [&](const float* from) {
+            size_t out{0};
+            float best{-1.0f};
+            for (size_t i = 0; i < meshlet.vertexCount; i++) {
+                const float d = distanceSquared(from, position(i));
+                if (d > best) {
+                    best = d;
+                    out = i;
+                }
+            }
+            return position(out);
+        };
+        const float* a = farthest(position(0));
+        const float* b = farthest(a);
+        float center[3]{(a[0] + b[0]) * 0.5f, (a[1] + b[1]) * 0.5f, (a[2] + b[2]) * 0.5f};
+        float radius = sqrt(distanceSquared(a, b)) * 0.5f;
+        for (size_t i = 0; i < meshlet.vertexCount; i++) {
+            const float* p = position(i);
+            const float d = sqrt(distanceSquared(center, p));
+            if (d <= radius) continue;
+            // 球面向该点扩张, 保持原球面上的最远点不变
+            const float grown = (radius + d) * 0.5f;
+            const float t = (grown - radius) / d;
+            for (size_t c = 0; c < 3; c++) {
+                center[c] += (p[c] - center[c]) * t;
+            }
+            radius = grown;
+        }
+        copy_n(center, 3, meshlet.center);
+        meshlet.radius = radius;
+    }
+
+    /**
+     * @brief 由三角形法线计算法线锥
+     * @details 轴为单位法线的均值方向, 最小夹角余弦过小[张角接近或超过 90 度]时不做锥剔除
+     */
+    void normalCone(const MeshletBuilder::MeshletMesh& mesh, MeshletBuilder::Meshlet& meshlet, const float* positions, const size_t stride) {
+        const unsigned int* vertices = mesh.vertices.data() + meshlet.vertexOffset;
+        const uint8_t* triangles = mesh.triangles.data() + meshlet.triangleOffset;
+        vector<float> normals{};
+        normals.reserve(meshlet.triangleCount * 3);
+        float axis[3]{};
+        for (size_t t = 0; t < meshlet.triangleCount; t++) {
+            const float* p0 = positions + size_t{vertices[triangles[t * 3]]} * stride;
+            const float* p1 = positions + size_t{vertices[triangles[t * 3 + 1]]} * stride;
+            const float* p2 = positions + size_t{vertices[triangles[t * 3 + 2]]} * stride;
+            const float e1[3]{p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            const float e2[3]{p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float n[3]{e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            const float length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length == 0.0f) continue;   // 退化三角形不影响朝向
+            for (size_t c = 0; c < 3; c++) {
+                n[c] /= length;
+                axis[c] += n[c];
+            }
+            normals.insert(normals.end(), n, n + 3);
+        }
+
+        meshlet.coneAxis[0] = meshlet.coneAxis[1] = meshlet.coneAxis[2] = 0.0f;
+        meshlet.coneCutoff = 1.0f;
+        const float length = sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        if (normals.empty() || length == 0.0f) return;
+        for (size_t c = 0; c < 3; c++) {
+            meshlet.coneAxis[c] = axis[c] / length;
+        }
+        float minDot{1.0f};
+        for (size_t i = 0; i < normals.size(); i += 3) {
+            minDot = min(minDot, normals[i] * meshlet.coneAxis[0] + normals[i + 1] * meshlet.coneAxis[1] + normals[i + 2] * meshlet.coneAxis[2]);
+        }
+        if (minDot <= 0.1f) return;
+        // 锥的半角为 acos(minDot), 剔除判定需要背向锥的半角 90 - acos(minDot), 其余弦即 sqrt(1 - minDot^2)
+        meshlet.coneCutoff = sqrt(1.0f - minDot * minDot);
+    }
+}
+
+MeshletBuilder::MeshletMesh MeshletBuilder::build(const std::vector<unsigned int> &indices, const float *positions, size_t vertexCount, size_t positionStride,
+    size_t vertexLimit, size_t triangleLimit) {
+    MeshletMesh mesh{};
+    if (indices.size() % 3 != 0) {
+        glog.log<DefaultLevel::Warn>("错误: 网格簇构建要求三角形列表索引, 索引数不是 3 的倍数");
+        return mesh;
+    }
+    if (any_of(indices.begin(), indices.end(), [&](const unsigned int e) { return e >= vertexCount; })) {
+        glog.log<DefaultLevel::Warn>("错误: 网格簇构建的索引超出顶点数量");
+        return mesh;
+    }
+    vertexLimit = clamp<size_t>(vertexLimit, 3, maxVertices);
+    triangleLimit = clamp<size_t>(triangleLimit, 1, maxTriangles);
+    const size_t triangleCount = indices.size() / 3;
+
+    // 顶点 -> 相邻三角形[CSR]
+    vector<unsigned int> adjacencyOffset(vertexCount + 1, 0);
+    for (const unsigned int e : indices) {
+        adjacencyOffset[e + 1]++;
+    }
+    for (size_t i = 0; i < vertexCount; i++) {
+        adjacencyOffset[i + 1] += adjacencyOffset[i];
+    }
+    vector<unsigned int> adjacency(indices.size());
+    {
+        vector<unsigned int> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++) {
+            adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+    }
+
+    vector<bool> used(triangleCount, false);
+    vector<unsigned int> local(vertexCount, invalidIndex);
+    Meshlet current{};
+    size_t cursor{0};
+
+    auto newVertices = [&](const size_t triangle) {
+        const unsigned int* t = indices.data() + triangle * 3;
+        size_t out{0};
+        for (size_t k = 0; k < 3; k++) {
+            // 三角形内重复的顶点只计一次
+            if (local[t[k]] == invalidIndex && (k == 0 || t[k] != t[0]) && (k < 2 || t[k] != t[1])) out++;
+        }
+        return out;
+    };
+    auto append = [&](const size_t triangle) {
+        used[triangle] = true;
+        for (size_t k = 0; k < 3; k++) {
+            const unsigned int v = indices[triangle * 3 + k];
+            if (local[v] == invalidIndex) {
+                local[v] = current.vertexCount++;
+                mesh.vertices.push_back(v);
+            }
+            mesh.triangles.push_back(static_cast<uint8_t>(local[v]));
+        }
+        current.triangleCount++;
+    };
+    auto flush = [&] {
+        for (size_t i = 0; i < current.vertexCount; i++) {
+            local[mesh.vertices[current.vertexOffset + i]] = invalidIndex;
+        }
+        boundingSphere(mesh, current, positions, positionStride);
+        normalCone(mesh, current, positions, positionStride);
+        mesh.meshlets.push_back(current);
+        current = Meshlet{};
+        current.vertexOffset = static_cast<uint32_t>(mesh.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(mesh.triangles.size());
+    };
+
+    while (true) {
+        while (cursor < triangleCount && used[cursor]) cursor++;
+        if (cursor == triangleCount) break;
+        append(cursor);
+
+        while (current.triangleCount < triangleLimit) {
+            // 在簇内顶点的相邻三角形中挑选新增顶点最少者
+            size_t best{triangleCount};
+            size_t bestCost{4};
+            for (size_t i = 0; i < current.vertexCount; i++) {
+                const unsigned int v = mesh.vertices[current.vertexOffset + i];
+                for (size_t j = adjacencyOffset[v]; j < adjacencyOffset[v + 1]; j++) {
+                    const unsigned int t = adjacency[j];
+                    if (used[t]) continue;
+                    const size_t cost = newVertices(t);
+                    if (cost < bestCost || (cost == bestCost && t < best)) {
+                        bestCost = cost;
+                        best = t;
+                    }
+                }
+            }
+            if (best == triangleCount || current.vertexCount + bestCost > vertexLimit) break;
+            append(best);
+        }
+        flush();
+    }
+    return mesh;
+}
+
+MeshletBuilder::MeshletMesh MeshletBuilder::build(const VertexLayout<float> &layout) {
+    const auto& elements = layout.elements();
+    const auto position = find_if(elements.begin(), elements.end(), [](const auto& e) {
+        return e.identifier == "vertices" && e.length >= 3;
+    });
+    if (position == elements.end() || layout.rawIndices().empty()) {
+        glog.log<DefaultLevel::Warn>("错误: 网格簇构建需要 vertices 元素与索引");
+        return {};
+    }
+    const vector<float>& buffer = layout.WeldIndices();
+    const size_t stride = elements[0].step / sizeof(float);
+    return build(layout.bufferOfIndices(), buffer.data() + position->origin / sizeof(float), buffer.size() / stride, stride);
+}
+
+std::map<std::string, MeshletBuilder::MeshletMesh> MeshletBuilder::build(const std::map<std::string, VertexLayout<float>> &models, size_t threads) {
+    vector<const pair<const string, VertexLayout<float>>*> tasks{};
+    tasks.reserve(models.size());
+    for (const auto& e : models) {
+        tasks.push_back(&e);
+    }
+    vector<MeshletMesh> results(tasks.size());
+    if (threads == 0) {
+        threads = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+    threads = min(threads, tasks.size());
+
+    // 各布局互不共享, 可各自在线程内组装; 以原子计数领取任务, 结果按任务序号写回
+    atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < tasks.size(); i = next++) {
+            results[i] = build(tasks[i]->second);
+        }
+    };
+    vector<thread> workers{};
+    for (size_t i = 1; i < threads; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& e : workers) {
+        e.join();
+    }
+
+    map<string, MeshletMesh> out{};
+    for (size_t i = 0; i < tasks.size(); i++) {
+        out.emplace(tasks[i]->first, std::move(results[i]));
+    }
+    return out;
+}
@@ -0,0 +1,335 @@
+#include "VertexEncoder.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <GlobalLogger.hpp>
+
+using namespace std;
+
+namespace {
+    inline size_t componentSize(const VertexEncoder::ComponentType type) {
+        switch (type) {
+            case VertexEncoder::ComponentType::Float32: return 4;
+            case VertexEncoder::ComponentType::Float16: return 2;
+            case VertexEncoder::ComponentType::Unorm16: return 2;
+            case VertexEncoder::ComponentType::Snorm16: return 2;
+            case VertexEncoder::ComponentType::Snorm1010102: return 4;
+        }
+        return 4;
+    }
+
+    inline size_t alignUp4(const size_t value) {
+        return (value + 3) & ~size_t{3};
+    }
+
+    inline float signNotZero(const float value) {
+        return value >= 0.0f ? 1.0f : -1.0f;
+    }
+
+    inline int16_t toSnorm16(const float value) {
+        return static_cast<int16_t>(lround(clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    inline float fromSnorm16(const int16_t value) {
+        return max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    inline uint16_t toUnorm16(const float value) {
+        return static_cast<uint16_t>(lround(clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    /**
+     * @brief 由元素源计算逐分量的取值范围, 作为 Unorm16Bounds 的解码参数
+     */
+    void boundsOf(const vector<float>& source, const size_t length, VertexEncoder::EncodedAttribute& attribute) {
+        for (size_t c = 0; c < length; c++) {
+            float low{numeric_limits<float>::max()}, high{numeric_limits<float>::lowest()};
+            for (size_t i = c; i < source.size(); i += length) {
+                low = min(low, source[i]);
+                high = max(high, source[i]);
+            }
+            if (low > high) {
+                low = high = 0.0f;
+            }
+            attribute.bias[c] = low;
+            attribute.scale[c] = high - low;
+        }
+    }
+}
+
+uint16_t VertexEncoder::floatToHalf(float value) {
+    const uint32_t bits = bit_cast<uint32_t>(value);
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFFu) {    // Inf / NaN
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u));
+    }
+    const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+    if (halfExponent >= 31) {   // 溢出
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (halfExponent <= 0) {    // 非规格化或下溢
+        if (halfExponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u))) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    const uint32_t rest = mantissa & 0x1FFFu;
+    // 就近舍入到偶数, 进位可自然溢出到指数
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float VertexEncoder::halfToFloat(uint16_t value) {
+    const uint32_t sign = (value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+    if (exponent == 0) {
+        const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+        return sign != 0 ? -magnitude : magnitude;
+    }
+    if (exponent == 31) {
+        return bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+    }
+    return bit_cast<float>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+}
+
+std::array<int16_t, 2> VertexEncoder::encodeOctahedral(const float *normal) {
+    const float l1 = fabs(normal[0]) + fabs(normal[1]) + fabs(normal[2]);
+    if (l1 == 0.0f) return {0, 0};
+    float x = normal[0] / l1;
+    float y = normal[1] / l1;
+    if (normal[2] < 0.0f) {
+        const float fx = (1.0f - fabs(y)) * signNotZero(x);
+        const float fy = (1.0f - fabs(x)) * signNotZero(y);
+        x = fx;
+        y = fy;
+    }
+    return {toSnorm16(x), toSnorm16(y)};
+}
+
+std::array<float, 3> VertexEncoder::decodeOctahedral(const std::array<int16_t, 2> &value) {
+    float x = fromSnorm16(value[0]);
+    float y = fromSnorm16(value[1]);
+    const float z = 1.0f - fabs(x) - fabs(y);
+    if (z < 0.0f) {
+        const float fx = (1.0f - fabs(y)) * signNotZero(x);
+        const float fy = (1.0f - fabs(x)) * signNotZero(y);
+        x = fx;
+        y = fy;
+    }
+    const float length = sqrt(x * x + y * y + z * z);
+    if (length == 0.0f) return {0.0f, 0.0f, 0.0f};
+    return {x / length, y / length, z / length};
+}
+
+uint32_t VertexEncoder::encodeSnorm1010102(const float *normal) {
+    uint32_t out{0};
+    for (size_t c = 0; c < 3; c++) {
+        const auto value = static_cast<int32_t>(lround(clamp(normal[c], -1.0f, 1.0f) * 511.0f));
+        out |= (static_cast<uint32_t>(value) & 0x3FFu) << (c * 10);
+    }
+    return out;
+}
+
+std::array<float, 3> VertexEncoder::decodeSnorm1010102(uint32_t value) {
+    std::array<float, 3> out{};
+    for (size_t c = 0; c < 3; c++) {
+        // 符号扩展 10 位分量
+        const int32_t component = static_cast<int32_t>(value << (22 - c * 10)) >> 22;
+        out[c] = max(static_cast<float>(component) / 511.0f, -1.0f);
+    }
+    return out;
+}
+
+VertexEncoder::EncodedMesh VertexEncoder::encode(const VertexLayout<float> &layout, const Options &options) {
+    EncodedMesh mesh{};
+    const auto& elements = layout.elements();
+    if (elements.empty()) {
+        glog.log<DefaultLevel::Warn>("错误: 编码的缓冲区组装布局未拥有任何元素");
+        return mesh;
+    }
+
+    // 确定各属性的存储格式与解码参数
+    for (const auto& e : elements) {
+        EncodedAttribute attribute{e.identifier, e.location, 0, e.length, e.length, ComponentType::Float32, false, false};
+        if (e.identifier == "vertices" && e.length == 3) {
+            switch (options.position) {
+                case PositionEncoding::Half:
+                    attribute.type = ComponentType::Float16;
+                    attribute.components = 4;
+                    break;
+                case PositionEncoding::Unorm16Bounds:
+                    attribute.type = ComponentType::Unorm16;
+                    attribute.components = 4;
+                    attribute.normalized = true;
+                    boundsOf(e.getSource(), e.length, attribute);
+                    break;
+                default: break;
+            }
+        } else if (e.identifier == "texCoord" && e.length == 2) {
+            switch (options.texCoord) {
+                case TexCoordEncoding::Half:
+                    attribute.type = ComponentType::Float16;
+                    break;
+                case TexCoordEncoding::Unorm16Bounds:
+                    attribute.type = ComponentType::Unorm16;
+                    attribute.normalized = true;
+                    boundsOf(e.getSource(), e.length, attribute);
+                    break;
+                default: break;
+            }
+        } else if (e.identifier == "normal" && e.length == 3) {
+            switch (options.normal) {
+                case NormalEncoding::Octahedral16:
+                    attribute.type = ComponentType::Snorm16;
+                    attribute.components = 2;
+                    attribute.normalized = true;
+                    attribute.octahedral = true;
+                    break;
+                case NormalEncoding::Snorm1010102:
+                    attribute.type = ComponentType::Snorm1010102;
+                    attribute.components = 4;
+                    attribute.normalized = true;
+                    break;
+                default: break;
+            }
+        }
+        attribute.offset = mesh.stride;
+        const size_t size = attribute.type == ComponentType::Snorm1010102 ? 4 : attribute.components * componentSize(attribute.type);
+        mesh.stride += alignUp4(size);
+        mesh.attributes.push_back(std::move(attribute));
+    }
+
+    const vector<float>& source = layout.WeldIndices();
+    const size_t floatStride = elements[0].step / sizeof(float);
+    mesh.vertexCount = source.size() / floatStride;
+    mesh.indices = layout.bufferOfIndices();
+    mesh.vertices.assign(mesh.vertexCount * mesh.stride, 0);
+
+    for (size_t v = 0; v < mesh.vertexCount; v++) {
+        uint8_t* target = mesh.vertices.data() + v * mesh.stride;
+        for (size_t i = 0; i < elements.size(); i++) {
+            const auto& attribute = mesh.attributes[i];
+            const float* value = source.data() + v * floatStride + elements[i].origin / sizeof(float);
+            uint8_t* out = target + attribute.offset;
+            switch (attribute.type) {
+                case ComponentType::Float32:
+                    memcpy(out, value, attribute.length * sizeof(float));
+                    break;
+                case ComponentType::Float16: {
+                    uint16_t packed[4]{0, 0, 0, 0x3C00u};
+                    for (size_t c = 0; c < attribute.length; c++) {
+                        packed[c] = floatToHalf(value[c]);
+                    }
+                    memcpy(out, packed, attribute.components * sizeof(uint16_t));
+                    break;
+                }
+                case ComponentType::Unorm16: {
+                    uint16_t packed[4]{0, 0, 0, 0xFFFFu};
+                    for (size_t c = 0; c < attribute.length; c++) {
+                        const float extent = attribute.scale[c];
+                        packed[c] = extent == 0.0f ? 0 : toUnorm16((value[c] - attribute.bias[c]) / extent);
+                    }
+                    memcpy(out, packed, attribute.components * sizeof(uint16_t));
+                    break;
+                }
+                case ComponentType::Snorm16: {
+                    const auto packed = encodeOctahedral(value);
+                    memcpy(out, packed.data(), sizeof(packed));
+                    break;
+                }
+                case ComponentType::Snorm1010102: {
+                    const uint32_t packed = encodeSnorm1010102(value);
+                    memcpy(out, &packed, sizeof(packed));
+                    break;
+                }
+            }
+        }
+    }
+    return mesh;
+}
+
+VertexEncoder::EncodedMesh VertexEncoder::encode(const VertexLayout<float> &layout) {
+    return encode(layout, Options{});
+}
+
+std::vector<float> VertexEncoder::decode(const EncodedMesh &mesh) {
+    size_t floatStride{0};
+    for (const auto& e : mesh.attributes) {
+        floatStride += e.length;
+    }
+    vector<float> out(mesh.vertexCount * floatStride);
+    for (size_t v = 0; v < mesh.vertexCount; v++) {
+        const uint8_t* source = mesh.vertices.data() + v * mesh.stride;
+        float* target = out.data() + v * floatStride;
+        for (const auto& attribute : mesh.attributes) {
+            const uint8_t* in = source + attribute.offset;
+            switch (attribute.type) {
+                case ComponentType::Float32:
+                    memcpy(target, in, attribute.length * sizeof(float));
+                    break;
+                case ComponentType::Float16:
+                    for (size_t c = 0; c < attribute.length; c++) {
+                        uint16_t packed;
+                        memcpy(&packed, in + c * sizeof(uint16_t), sizeof(uint16_t));
+                        target[c] = halfToFloat(packed);
+                    }
+                    break;
+                case ComponentType::Unorm16:
+                    for (size_t c = 0; c < attribute.length; c++) {
+                        uint16_t packed;
+                        memcpy(&packed, in + c * sizeof(uint16_t), sizeof(uint16_t));
+                        target[c] = attribute.bias[c] + attribute.scale[c] * (static_cast<float>(packed) / 65535.0f);
+                    }
+                    break;
+                case ComponentType::Snorm16: {
+                    std::array<int16_t, 2> packed{};
+                    memcpy(packed.data(), in, sizeof(packed));
+                    const auto normal = decodeOctahedral(packed);
+                    copy_n(normal.begin(), 3, target);
+                    break;
+                }
+                case ComponentType::Snorm1010102: {
+                    uint32_t packed;
+                    memcpy(&packed, in, sizeof(packed));
+                    const auto normal = decodeSnorm1010102(packed);
+                    copy_n(normal.begin(), 3, target);
+                    break;
+                }
+            }
+            target += attribute.length;
+        }
+    }
+    return out;
+}
+
+std::vector<float> VertexEncoder::maxError(const VertexLayout<float> &layout, const EncodedMesh &mesh) {
+    const vector<float>& source = layout.WeldIndices();
+    const vector<float> decoded = decode(mesh);
+    vector<float> out(mesh.attributes.size(), 0.0f);
+    if (source.size() != decoded.size()) {
+        glog.log<DefaultLevel::Warn>("错误: 编码结果与缓冲区组装布局不匹配");
+        return out;
+    }
+    const size_t floatStride = mesh.vertexCount == 0 ? 0 : source.size() / mesh.vertexCount;
+    for (size_t v = 0; v < mesh.vertexCount; v++) {
+        size_t offset = v * floatStride;
+        for (size_t i = 0; i < mesh.attributes.size(); i++) {
+            for (size_t c = 0; c < mesh.attributes[i].length; c++, offset++) {
+                out[i] = max(out[i], fabs(source[offset] - decoded[offset]));
+            }
+        }
+    }
+    return out;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include <VertexLayout.hpp>
+
+/**
+ * @brief 网格优化
+ * @details 独立于渲染的 CPU 阶段, 仅处理三角形列表形式的索引;
+ * 先按顶点后变换缓存重排三角形[Forsyth], 再以簇为单位按朝向重排以减少过度绘制[Sander 等],
+ * 最后按首次使用顺序重排顶点以改善取顶点的局部性
+ */
+class MeshOptimizer {
+    public:
+        /**
+         * @brief 顶点缓存统计
+         */
+        struct CacheStatistics {
+            size_t triangles{};
+            size_t vertices{};
+            size_t transforms{};    // 模拟缓存未命中即需变换的顶点次数
+            float acmr{};           // 平均每个三角形的缓存未命中数[1.0 ~ 3.0, 越低越好]
+            float atvr{};           // 平均每个顶点的变换次数[1.0 为理想值]
+        };
+
+        /**
+         * @brief 优化前后的统计
+         */
+        struct Report {
+            CacheStatistics before;
+            CacheStatistics after;
+        };
+
+        static constexpr size_t defaultCacheSize{16};
+        static constexpr float defaultOverdrawThreshold{1.05f};
+
+        ~MeshOptimizer() = default;
+
+        /**
+         * @brief 以 FIFO 缓存模拟统计 ACMR/ATVR
+         * @details 他似乎不需要详细注释[划掉]
+         * @param indices 三角形列表索引
+         * @param vertexCount 顶点数量
+         * @param cacheSize 模拟缓存大小
+         * @return 顶点缓存统计
+         */
+        static CacheStatistics analyzeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount, size_t cacheSize = defaultCacheSize);
+
+        /**
+         * @brief 计算顶点缓存友好的三角形顺序
+         * @details Forsyth 线性速度算法, 以 32 项 LRU 缓存为模型打分, 无候选三角形时按输入顺序取下一个未输出的三角形, 结果确定
+         * @param indices 三角形列表索引
+         * @param vertexCount 顶点数量
+         * @return 新顺序下第 i 个三角形在原索引中的序号
+         */
+        static std::vector<unsigned int> vertexCacheOrder(const std::vector<unsigned int>& indices, size_t vertexCount);
+
+        /**
+         * @brief 按顶点缓存重排三角形
+         * @details 他似乎不需要详细注释[划掉]
+         * @param indices 三角形列表索引
+         * @param vertexCount 顶点数量
+         * @return 重排后的索引
+         */
+        static std::vector<unsigned int> optimizeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount);
+
+        /**
+         * @brief 计算减少过度绘制的三角形顺序
+         * @details 输入须已按顶点缓存排序; 在模拟缓存的顶点全部未命中处切分硬簇, 硬簇内在累计 ACMR 不超过 threshold 倍硬簇 ACMR 处再切分;
+         * 各簇按 [簇中心 - 网格中心]·簇法线 从大到小稳定排序, 朝外的簇先绘制, 以深度测试剔除其后的片元
+         * @param indices 三角形列表索引
+         * @param positions 首个顶点的位置
+         * @param vertexCount 顶点数量
+         * @param stride 顶点步长[float 的个数]
+         * @param threshold 允许的 ACMR 放大倍数[越大簇越小, 排序越自由]
+         * @param cacheSize 切分使用的模拟缓存大小
+         * @return 新顺序下第 i 个三角形在原索引中的序号
+         */
+        static std::vector<unsigned int> overdrawOrder(const std::vector<unsigned int>& indices, const float* positions, size_t vertexCount, size_t stride,
+            float threshold = defaultOverdrawThreshold, size_t cacheSize = defaultCacheSize);
+
+        /**
+         * @brief 按过度绘制重排三角形
+         * @details 他似乎不需要详细注释[划掉]
+         * @param indices 已按顶点缓存排序的三角形列表索引
+         * @param positions 首个顶点的位置
+         * @param vertexCount 顶点数量
+         * @param stride 顶点步长[float 的个数]
+         * @param threshold 允许的 ACMR 放大倍数
+         * @return 重排后的索引
+         */
+        static std::vector<unsigned int> optimizeOverdraw(const std::vector<unsigned int>& indices, const float* positions, size_t vertexCount, size_t stride,
+            float threshold = defaultOverdrawThreshold);
+
+        /**
+         * @brief 按过度绘制重排指向焊接顶点的三角形
+         * @details 位置取自 layout 焊接组装结果中的 vertices 元素, 没有该元素时原样返回
+         * @param indices 已按顶点缓存排序且指向焊接顶点的三角形列表索引
+         * @param layout 缓冲区组装布局
+         * @param threshold 允许的 ACMR 放大倍数
+         * @return 重排后的索引
+         */
+        static std::vector<unsigned int> optimizeOverdraw(const std::vector<unsigned int>& indices, const VertexLayout<float>& layout,
+            float threshold = defaultOverdrawThreshold);
+
+        /**
+         * @brief 优化缓冲区组装布局
+         * @details 先焊接得到真实索引, 依其计算顶点缓存顺序与过度绘制顺序并重排原始面角索引, 再次焊接时顶点按首次使用顺序编号, 即完成取顶点重排;
+         * 没有 vertices 元素或 overdrawThreshold 为 0 时跳过过度绘制重排; 优化后布局处于焊接组装状态, 原始面角数不是 3 的倍数时不做处理
+         * @param layout 缓冲区组装布局
+         * @param cacheSize 统计使用的模拟缓存大小
+         * @param overdrawThreshold 过度绘制重排允许的 ACMR 放大倍数
+         * @return 优化前后的统计
+         */
+        static Report optimize(VertexLayout<float>& layout, size_t cacheSize = defaultCacheSize, float overdrawThreshold = defaultOverdrawThreshold);
+};
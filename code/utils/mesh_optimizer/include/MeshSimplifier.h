@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <VertexLayout.hpp>
+
+/**
+ * @brief 基于二次误差度量[QEM]的网格简化
+ * @details 只做边折叠到已有顶点, 不产生新顶点, 简化结果是原顶点缓冲上的新索引;
+ * 位置误差由平面二次误差度量给出, 其余属性[纹理坐标/法线等]以折叠两端的属性差的平方加权计入折叠代价;
+ * 报告与限制使用的位置误差不含属性项, 为折叠目标到相关原始平面的面积加权均方根距离
+ */
+class MeshSimplifier {
+    public:
+        /**
+         * @brief 简化选项
+         */
+        struct Options {
+            bool lockBorder{true};          // 锁定边界顶点[开放边界与属性接缝], 否则边界顶点仅沿边界折叠
+            float attributeWeight{1.0f};    // 属性误差权重
+            float maxError{std::numeric_limits<float>::max()};  // 单次折叠允许的最大位置误差[距离量纲, 不含属性项]
+        };
+
+        /**
+         * @brief 单级细节层次
+         */
+        struct Lod {
+            float ratio;    // 目标三角形比例
+            float error;    // 相对原始网格的位置误差上界[距离量纲, 各级最大位置误差之和]
+            std::vector<unsigned int> indices;
+        };
+
+        ~MeshSimplifier() = default;
+
+        /**
+         * @brief 简化三角形列表
+         * @details 按误差从小到大分轮折叠, 每轮中一个顶点至多参与一次折叠, 折叠导致邻接三角形翻转时放弃该折叠;
+         * 无法继续折叠[边界锁定/误差超限]时返回的三角形数可能多于目标
+         * @param indices 三角形列表索引
+         * @param vertices 交错顶点数据
+         * @param vertexCount 顶点数量
+         * @param stride 顶点步长[float 的个数]
+         * @param positionOffset 位置在顶点内的偏移[float 的个数]
+         * @param targetIndexCount 目标索引数
+         * @param options 简化选项
+         * @param resultError 输出实际折叠中的最大位置误差[可为空]
+         * @return 简化后的索引
+         */
+        static std::vector<unsigned int> simplify(const std::vector<unsigned int>& indices, const float* vertices, size_t vertexCount, size_t stride,
+            size_t positionOffset, size_t targetIndexCount, const Options& options, float* resultError = nullptr);
+
+        /**
+         * @brief 生成细节层次链
+         * @details 以焊接组装的结果为输入, 各级依次在上一级的结果上继续简化, 索引均指向焊接后的顶点
+         * @param layout 缓冲区组装布局
+         * @param ratios 各级目标三角形比例[递减]
+         * @param options 简化选项
+         * @return 细节层次链[不含原始网格]
+         */
+        static std::vector<Lod> buildLodChain(const VertexLayout<float>& layout, const std::vector<float>& ratios, const Options& options);
+
+        /**
+         * @brief 以默认选项生成细节层次链
+         * @details 他似乎不需要详细注释[划掉]
+         * @param layout 缓冲区组装布局
+         * @param ratios 各级目标三角形比例[递减]
+         * @return 细节层次链[不含原始网格]
+         */
+        static std::vector<Lod> buildLodChain(const VertexLayout<float>& layout, const std::vector<float>& ratios = {0.5f, 0.25f, 0.1f});
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <VertexLayout.hpp>
+
+/**
+ * @brief 网格簇[meshlet]构建
+ * @details 将三角形列表索引切分为顶点与三角形数量受限的簇, 每个簇附带包围球与法线锥, 供渲染时按簇剔除;
+ * 输入最好先经 MeshOptimizer 重排, 相邻三角形更集中时簇的顶点复用率更高
+ */
+class MeshletBuilder {
+    public:
+        static constexpr size_t maxVertices{64};
+        static constexpr size_t maxTriangles{124};
+
+        /**
+         * @brief 单个网格簇
+         * @details 法线锥剔除: dot(center - 相机位置, coneAxis) >= coneCutoff * |center - 相机位置| + radius 时整簇背向相机;
+         * 法线分布过散时 coneCutoff 为 1, 即不参与锥剔除
+         */
+        struct Meshlet {
+            uint32_t vertexOffset;      // 在 MeshletMesh::vertices 中的起始位置
+            uint32_t vertexCount;
+            uint32_t triangleOffset;    // 在 MeshletMesh::triangles 中的起始位置[以字节计]
+            uint32_t triangleCount;
+            float center[3];
+            float radius;
+            float coneAxis[3];
+            float coneCutoff;
+        };
+
+        /**
+         * @brief 切分结果
+         * @details vertices 为簇内局部顶点到网格顶点的映射, triangles 为每个三角形 3 个簇内局部索引
+         */
+        struct MeshletMesh {
+            std::vector<Meshlet> meshlets;
+            std::vector<unsigned int> vertices;
+            std::vector<uint8_t> triangles;
+        };
+
+        ~MeshletBuilder() = default;
+
+        /**
+         * @brief 切分三角形列表
+         * @details 从首个未使用的三角形起, 反复加入与簇共享顶点最多的相邻三角形[同分取序号较小者], 结果确定
+         * @param indices 三角形列表索引
+         * @param positions 顶点位置[每个顶点前 3 个分量]
+         * @param vertexCount 顶点数量
+         * @param positionStride 相邻顶点位置的间隔[float 的个数]
+         * @param vertexLimit 单簇顶点上限[不超过 maxVertices]
+         * @param triangleLimit 单簇三角形上限[不超过 maxTriangles]
+         * @return 切分结果
+         */
+        static MeshletMesh build(const std::vector<unsigned int>& indices, const float* positions, size_t vertexCount, size_t positionStride,
+            size_t vertexLimit = maxVertices, size_t triangleLimit = maxTriangles);
+
+        /**
+         * @brief 切分缓冲区组装布局
+         * @details 以焊接组装的结果为输入, 顶点位置取自 vertices 元素, 簇的顶点映射指向焊接后的顶点
+         * @param layout 缓冲区组装布局
+         * @return 切分结果
+         */
+        static MeshletMesh build(const VertexLayout<float>& layout);
+
+        /**
+         * @brief 多线程切分全部对象
+         * @details 以对象为单位分配到各线程, 结果与逐个调用 build 一致
+         * @param models 以对象名为键的缓冲区组装布局表
+         * @param threads 线程数[0 表示硬件并发数]
+         * @return 以对象名为键的切分结果
+         */
+        static std::map<std::string, MeshletMesh> build(const std::map<std::string, VertexLayout<float>>& models, size_t threads = 0);
+};
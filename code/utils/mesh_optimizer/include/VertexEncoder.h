@@ -0,0 +1,147 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <VertexLayout.hpp>
+
+/**
+ * @brief 顶点属性量化编码
+ * @details 将焊接后的 float 顶点编码为紧凑格式并给出对应的解码参数, 解码值 = bias + scale * 归一化值;
+ * 所有属性按 4 字节对齐, 位置 + 纹理坐标 + 法线 由 32 字节降为 16 字节
+ */
+class VertexEncoder {
+    public:
+        /**
+         * @brief 位置编码
+         */
+        enum class PositionEncoding {
+            Float32,
+            Half,           // 半精度浮点[补第 4 分量对齐]
+            Unorm16Bounds   // 相对包围盒的 16 位无符号归一化[补第 4 分量对齐]
+        };
+
+        /**
+         * @brief 纹理坐标编码
+         */
+        enum class TexCoordEncoding {
+            Float32,
+            Half,
+            Unorm16Bounds   // 相对取值范围的 16 位无符号归一化
+        };
+
+        /**
+         * @brief 法线编码
+         */
+        enum class NormalEncoding {
+            Float32,
+            Octahedral16,   // 八面体映射后的 snorm16x2
+            Snorm1010102    // 10:10:10:2 有符号归一化[对应 GL_INT_2_10_10_10_REV]
+        };
+
+        /**
+         * @brief 分量类型
+         */
+        enum class ComponentType {
+            Float32,
+            Float16,
+            Unorm16,
+            Snorm16,
+            Snorm1010102
+        };
+
+        /**
+         * @brief 编码选项
+         * @details 按元素标识符[vertices/texCoord/normal]匹配, 其余元素保持 float
+         */
+        struct Options {
+            PositionEncoding position{PositionEncoding::Unorm16Bounds};
+            TexCoordEncoding texCoord{TexCoordEncoding::Unorm16Bounds};
+            NormalEncoding normal{NormalEncoding::Octahedral16};
+        };
+
+        /**
+         * @brief 编码后的属性描述
+         * @details components 为存储分量数, length 为解码后的元素长度;
+         * 八面体法线以 2 分量存储, 需在着色器中按 decodeOctahedral 还原
+         */
+        struct EncodedAttribute {
+            std::string identifier;
+            size_t location;
+            size_t offset;      // 字节偏移
+            size_t components;
+            size_t length;
+            ComponentType type;
+            bool normalized;
+            bool octahedral;
+            std::array<float, 4> scale{1.0f, 1.0f, 1.0f, 1.0f};
+            std::array<float, 4> bias{};
+        };
+
+        /**
+         * @brief 编码后的网格
+         */
+        struct EncodedMesh {
+            std::vector<uint8_t> vertices;
+            std::vector<unsigned int> indices;
+            std::vector<EncodedAttribute> attributes;
+            size_t stride{};    // 字节
+            size_t vertexCount{};
+        };
+
+        ~VertexEncoder() = default;
+
+        /**
+         * @brief 编码缓冲区组装布局
+         * @details 以焊接组装的结果为输入, 索引原样保留
+         * @param layout 缓冲区组装布局
+         * @param options 编码选项
+         * @return 编码后的网格
+         */
+        static EncodedMesh encode(const VertexLayout<float>& layout, const Options& options);
+
+        /**
+         * @brief 以默认选项编码缓冲区组装布局
+         * @details 位置与纹理坐标相对取值范围量化为 unorm16, 法线八面体编码
+         * @param layout 缓冲区组装布局
+         * @return 编码后的网格
+         */
+        static EncodedMesh encode(const VertexLayout<float>& layout);
+
+        /**
+         * @brief 解码为与焊接组装相同排布的 float 缓冲
+         * @details 用于校验与误差统计
+         * @param mesh 编码后的网格
+         * @return 交错顶点数据
+         */
+        static std::vector<float> decode(const EncodedMesh& mesh);
+
+        /**
+         * @brief 统计各属性的最大绝对误差
+         * @details 他似乎不需要详细注释[划掉]
+         * @param layout 编码源
+         * @param mesh 编码后的网格
+         * @return 按 location 顺序的最大绝对误差
+         */
+        static std::vector<float> maxError(const VertexLayout<float>& layout, const EncodedMesh& mesh);
+
+        static uint16_t floatToHalf(float value);
+
+        static float halfToFloat(uint16_t value);
+
+        /**
+         * @brief 八面体编码
+         * @details 输入无需归一化, 零向量编码为 (0, 0)
+         * @param normal 法线
+         * @return snorm16x2
+         */
+        static std::array<int16_t, 2> encodeOctahedral(const float* normal);
+
+        static std::array<float, 3> decodeOctahedral(const std::array<int16_t, 2>& value);
+
+        static uint32_t encodeSnorm1010102(const float* normal);
+
+        static std::array<float, 3> decodeSnorm1010102(uint32_t value);
+};
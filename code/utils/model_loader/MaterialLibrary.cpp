@@ -0,0 +1,149 @@
+#include "MaterialLibrary.h"
+#include <charconv>
+#include <cstring>
+
+#include <GlobalLogger.hpp>
+#include <MappedFile.hpp>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+    inline bool isBlank(const char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline string_view trim(string_view value) {
+        while (!value.empty() && isBlank(value.front())) value.remove_prefix(1);
+        while (!value.empty() && isBlank(value.back())) value.remove_suffix(1);
+        return value;
+    }
+
+    /**
+     * @brief 拆出行首记号, rest 为其后的剩余部分
+     */
+    inline string_view splitKey(string_view line, string_view& rest) {
+        line = trim(line);
+        size_t end{0};
+        while (end < line.size() && !isBlank(line[end])) end++;
+        rest = trim(line.substr(end));
+        return line.substr(0, end);
+    }
+
+    inline float parseFloat(string_view& rest) {
+        rest = trim(rest);
+        float out{0.0f};
+        const char* begin = rest.data();
+        if (!rest.empty() && *begin == '+') begin++;
+        auto [ptr, ec] = from_chars(begin, rest.data() + rest.size(), out);
+        if (ec != errc{}) return 0.0f;
+        rest.remove_prefix(static_cast<size_t>(ptr - rest.data()));
+        return out;
+    }
+
+    inline void parseColor(string_view rest, float (&out)[3]) {
+        // 仅给出一个分量时视为灰度
+        out[0] = parseFloat(rest);
+        rest = trim(rest);
+        if (rest.empty()) {
+            out[1] = out[2] = out[0];
+            return;
+        }
+        out[1] = parseFloat(rest);
+        out[2] = parseFloat(rest);
+    }
+
+    /**
+     * @brief 解析贴图记录
+     * @details 贴图选项[-bm 1.0 等]位于路径之前, 取最后一个记号为路径; 相对路径按 mtl 所在目录解析
+     */
+    inline string texturePath(string_view rest, const fs::path& directory) {
+        size_t begin = rest.size();
+        while (begin != 0 && !isBlank(rest[begin - 1])) begin--;
+        const string_view file = rest.substr(begin);
+        if (file.empty()) return {};
+        const fs::path path{string(file)};
+        // 带盘符的路径[D:/...]在非 Windows 平台上不被视为绝对路径, 同样原样保留
+        const bool drive = file.size() > 1 && file[1] == ':';
+        if (path.is_absolute() || drive || directory.empty()) return path.generic_string();
+        return (directory / path).lexically_normal().generic_string();
+    }
+}
+
+uint32_t MaterialLibrary::intern(std::string_view name) {
+    if (const auto it = _ids.find(name); it != _ids.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<uint32_t>(_materials.size());
+    Material material{};
+    material.name = string(name);
+    _materials.push_back(std::move(material));
+    _ids.emplace(string(name), id);
+    return id;
+}
+
+uint32_t MaterialLibrary::find(std::string_view name) const {
+    const auto it = _ids.find(name);
+    return it == _ids.end() ? invalidId : it->second;
+}
+
+size_t MaterialLibrary::parse(std::string_view source, const std::filesystem::path &directory) {
+    size_t defined{0};
+    Material* current{nullptr};
+    while (!source.empty()) {
+        const size_t lineEnd = source.find('\n');
+        const string_view line = source.substr(0, lineEnd);
+        source.remove_prefix(lineEnd == string_view::npos ? source.size() : lineEnd + 1);
+
+        string_view rest;
+        const string_view key = splitKey(line, rest);
+        if (key.empty() || key[0] == '#') continue;
+        if (key == "newmtl") {
+            current = &_materials[intern(rest)];
+            defined++;
+            continue;
+        }
+        if (current == nullptr) continue;
+        if (key == "Ka") parseColor(rest, current->ambient);
+        else if (key == "Kd") parseColor(rest, current->diffuse);
+        else if (key == "Ks") parseColor(rest, current->specular);
+        else if (key == "Ke") parseColor(rest, current->emissive);
+        else if (key == "Ns") current->shininess = parseFloat(rest);
+        else if (key == "Ni") current->opticalDensity = parseFloat(rest);
+        else if (key == "d") current->dissolve = parseFloat(rest);
+        else if (key == "Tr") current->dissolve = 1.0f - parseFloat(rest);
+        else if (key == "illum") current->illumination = static_cast<int>(parseFloat(rest));
+        else if (key == "map_Ka") current->ambientMap = texturePath(rest, directory);
+        else if (key == "map_Kd") current->diffuseMap = texturePath(rest, directory);
+        else if (key == "map_Ks") current->specularMap = texturePath(rest, directory);
+        else if (key == "map_Bump" || key == "map_bump" || key == "bump" || key == "norm") current->normalMap = texturePath(rest, directory);
+        else if (key == "map_d") current->alphaMap = texturePath(rest, directory);
+    }
+    return defined;
+}
+
+bool MaterialLibrary::load(const std::filesystem::path &path) {
+    const MappedFile file(path);
+    if (file.empty()) {
+        glog.log<DefaultLevel::Warn>("错误: mtl文件为空或无法映射: " + path.string());
+        return false;
+    }
+    parse(file.view(), path.parent_path());
+    return true;
+}
+
+size_t MaterialLibrary::size() const {
+    return _materials.size();
+}
+
+const std::vector<Material>& MaterialLibrary::materials() const {
+    return _materials;
+}
+
+const Material& MaterialLibrary::operator[](uint32_t id) const {
+    return _materials[id];
+}
+
+Material& MaterialLibrary::operator[](uint32_t id) {
+    return _materials[id];
+}
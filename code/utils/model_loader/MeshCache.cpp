@@ -0,0 +1,311 @@
+#include "MeshCache.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <GlobalLogger.hpp>
+#include <StaticVertexFormat.hpp>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+    inline size_t alignUp(const size_t value) {
+        return (value + MeshCache::alignment - 1) & ~(MeshCache::alignment - 1);
+    }
+
+    /**
+     * @brief 追加数据块并返回其对齐后的偏移
+     */
+    inline uint64_t appendBlock(vector<char>& out, const void* data, const size_t size) {
+        const size_t offset = alignUp(out.size());
+        out.resize(offset + size);
+        if (size != 0) {
+            memcpy(out.data() + offset, data, size);
+        }
+        return offset;
+    }
+
+    inline bool inBounds(const uint64_t offset, const uint64_t size, const size_t fileSize) {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+}
+
+MeshCache::CookedMesh::CookedMesh(const std::filesystem::path &path) {
+    if (!fs::exists(path)) return;
+    _file = MappedFile(path, false);
+    const size_t fileSize = _file.size();
+    const char* base = _file.data();
+    if (fileSize < sizeof(FileHeader)) return;
+
+    memcpy(&_header, base, sizeof(FileHeader));
+    if (memcmp(_header.magic, magic, sizeof(magic)) != 0 || _header.version != version) {
+        glog.log<DefaultLevel::Debug>("预处理网格缓存版本不符: " + path.string());
+        return;
+    }
+    if (!inBounds(_header.objectTableOffset, uint64_t{_header.objectCount} * sizeof(ObjectRecord), fileSize)
+        || _header.objectTableOffset % alignment != 0) return;
+
+    auto* objectTable = reinterpret_cast<const ObjectRecord*>(base + _header.objectTableOffset);
+    _objects.reserve(_header.objectCount);
+    for (uint32_t i = 0; i < _header.objectCount; i++) {
+        const ObjectRecord& object = objectTable[i];
+        if (!inBounds(object.nameOffset, object.nameLength, fileSize)
+            || !inBounds(object.elementTableOffset, uint64_t{object.elementCount} * sizeof(ElementRecord), fileSize)
+            || !inBounds(object.indicesOffset, object.indexCount * sizeof(unsigned int), fileSize)
+            || !inBounds(object.lodTableOffset, uint64_t{object.lodCount} * sizeof(LodRecord), fileSize)
+            || object.elementTableOffset % alignment != 0
+            || object.indicesOffset % alignment != 0
+            || object.lodTableOffset % alignment != 0) {
+            _objects.clear();
+            return;
+        }
+        ObjectView view{
+            {base + object.nameOffset, object.nameLength},
+            {},
+            {reinterpret_cast<const unsigned int*>(base + object.indicesOffset), object.indexCount},
+            {}
+        };
+        auto* elementTable = reinterpret_cast<const ElementRecord*>(base + object.elementTableOffset);
+        view.elements.reserve(object.elementCount);
+        for (uint32_t j = 0; j < object.elementCount; j++) {
+            const ElementRecord& element = elementTable[j];
+            if (!inBounds(element.identifierOffset, element.identifierLength, fileSize)
+                || !inBounds(element.sourceOffset, element.sourceCount * sizeof(float), fileSize)
+                || element.sourceOffset % alignment != 0) {
+                _objects.clear();
+                return;
+            }
+            view.elements.push_back(ElementView{
+                {base + element.identifierOffset, element.identifierLength},
+                element.length,
+                element.location,
+                {reinterpret_cast<const float*>(base + element.sourceOffset), element.sourceCount}
+            });
+        }
+        auto* lodTable = reinterpret_cast<const LodRecord*>(base + object.lodTableOffset);
+        view.lods.reserve(object.lodCount);
+        for (uint32_t j = 0; j < object.lodCount; j++) {
+            const LodRecord& lod = lodTable[j];
+            if (!inBounds(lod.indicesOffset, lod.indexCount * sizeof(unsigned int), fileSize)
+                || lod.indicesOffset % alignment != 0) {
+                _objects.clear();
+                return;
+            }
+            view.lods.push_back(LodView{
+                lod.ratio,
+                lod.error,
+                {reinterpret_cast<const unsigned int*>(base + lod.indicesOffset), lod.indexCount}
+            });
+        }
+        _objects.push_back(std::move(view));
+    }
+    _isValid = true;
+}
+
+bool MeshCache::CookedMesh::valid() const {
+    return _isValid;
+}
+
+bool MeshCache::CookedMesh::matches(const SourceStamp &stamp) const {
+    if (!_isValid) return false;
+    if (_header.sourceSize != stamp.size) return false;
+    if ((_header.flags & stamp.flags) != stamp.flags) return false;
+    if (_header.sourceTime == stamp.time) return true;
+    return stamp.hash != 0 && _header.sourceHash == stamp.hash;
+}
+
+const MeshCache::FileHeader& MeshCache::CookedMesh::header() const {
+    return _header;
+}
+
+const std::vector<MeshCache::CookedMesh::ObjectView>& MeshCache::CookedMesh::objects() const {
+    return _objects;
+}
+
+std::map<std::string, VertexLayout<float>> MeshCache::CookedMesh::toLayouts() const {
+    map<string, VertexLayout<float>> models{};
+    for (const auto& object : _objects) {
+        vector<const ElementView*> ordered{};
+        ordered.reserve(object.elements.size());
+        for (const auto& e : object.elements) {
+            ordered.push_back(&e);
+        }
+        sort(ordered.begin(), ordered.end(), [](const ElementView* a, const ElementView* b) {
+            return a->location < b->location;
+        });
+
+        auto builder = VertexLayout<float>::builder();
+        for (const auto* e : ordered) {
+            const string identifier{e->identifier};
+            builder.appendElement(identifier, e->length)
+                .attachSource(identifier, vector<float>(e->source.begin(), e->source.end()));
+        }
+        if (!object.indices.empty()) {
+            builder.attachIndices(vector<unsigned int>(object.indices.begin(), object.indices.end()));
+        }
+        auto layout = builder.build();
+        if (vertex_format::PositionTexCoordNormal::matches(layout)) {
+            layout.bindFormat<vertex_format::PositionTexCoordNormal>();
+        }
+        models.insert_or_assign(string(object.name), std::move(layout));
+    }
+    return models;
+}
+
+bool MeshCache::CookedMesh::hasLods(const std::vector<float> &ratios) const {
+    return all_of(_objects.begin(), _objects.end(), [&](const ObjectView& object) {
+        // 无面的对象不生成细节层次
+        if (object.indices.empty()) return true;
+        return equal(object.lods.begin(), object.lods.end(), ratios.begin(), ratios.end(), [](const LodView& lod, const float ratio) {
+            return lod.ratio == ratio;
+        });
+    });
+}
+
+std::map<std::string, std::vector<MeshSimplifier::Lod>> MeshCache::CookedMesh::toLods() const {
+    map<string, vector<MeshSimplifier::Lod>> out{};
+    for (const auto& object : _objects) {
+        vector<MeshSimplifier::Lod> lods{};
+        lods.reserve(object.lods.size());
+        for (const auto& e : object.lods) {
+            lods.push_back(MeshSimplifier::Lod{e.ratio, e.error, vector<unsigned int>(e.indices.begin(), e.indices.end())});
+        }
+        out.insert_or_assign(string(object.name), std::move(lods));
+    }
+    return out;
+}
+
+uint64_t MeshCache::hash(std::string_view content) {
+    constexpr uint64_t prime = 0x9E3779B97F4A7C15ull;
+    uint64_t h = 0xCBF29CE484222325ull ^ content.size();
+    const char* data = content.data();
+    const size_t size = content.size();
+    size_t i{0};
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(uint64_t));
+        h = (h ^ word) * prime;
+        h ^= h >> 32;
+    }
+    if (i < size) {
+        uint64_t word{0};
+        memcpy(&word, data + i, size - i);
+        h = (h ^ word) * prime;
+        h ^= h >> 29;
+    }
+    return h == 0 ? 1 : h;
+}
+
+MeshCache::SourceStamp MeshCache::stamp(const std::filesystem::path &path, std::string_view content) {
+    SourceStamp out{};
+    error_code ec;
+    out.size = fs::file_size(path, ec);
+    if (ec) return {};
+    out.time = fs::last_write_time(path, ec).time_since_epoch().count();
+    if (!content.empty()) {
+        out.hash = hash(content);
+    }
+    return out;
+}
+
+std::filesystem::path MeshCache::cachePath(const std::filesystem::path &source) {
+    fs::path out = source;
+    out += ".cooked";
+    return out;
+}
+
+bool MeshCache::write(const std::filesystem::path &path, const SourceStamp &stamp, const std::map<std::string, VertexLayout<float>> &models,
+    const std::map<std::string, std::vector<MeshSimplifier::Lod>> &lods) {
+    vector<char> out(sizeof(FileHeader));
+    vector<ObjectRecord> objects{};
+    objects.reserve(models.size());
+
+    for (const auto& [name, layout] : models) {
+        ObjectRecord object{};
+        object.nameOffset = appendBlock(out, name.data(), name.size());
+        object.nameLength = static_cast<uint32_t>(name.size());
+
+        vector<ElementRecord> elements{};
+        for (const auto& e : layout.elements()) {
+            ElementRecord element{};
+            element.identifierOffset = appendBlock(out, e.identifier.data(), e.identifier.size());
+            element.identifierLength = static_cast<uint32_t>(e.identifier.size());
+            element.length = static_cast<uint32_t>(e.length);
+            element.location = static_cast<uint32_t>(e.location);
+            element.sourceOffset = appendBlock(out, e.getSource().data(), e.getSource().size() * sizeof(float));
+            element.sourceCount = e.getSource().size();
+            elements.push_back(element);
+        }
+        object.elementCount = static_cast<uint32_t>(elements.size());
+        object.elementTableOffset = appendBlock(out, elements.data(), elements.size() * sizeof(ElementRecord));
+
+        const auto& indices = layout.rawIndices();
+        object.indicesOffset = appendBlock(out, indices.data(), indices.size() * sizeof(unsigned int));
+        object.indexCount = indices.size();
+
+        vector<LodRecord> lodRecords{};
+        if (const auto it = lods.find(name); it != lods.end()) {
+            for (const auto& e : it->second) {
+                LodRecord lod{};
+                lod.ratio = e.ratio;
+                lod.error = e.error;
+                lod.indicesOffset = appendBlock(out, e.indices.data(), e.indices.size() * sizeof(unsigned int));
+                lod.indexCount = e.indices.size();
+                lodRecords.push_back(lod);
+            }
+        }
+        object.lodCount = static_cast<uint32_t>(lodRecords.size());
+        object.lodTableOffset = appendBlock(out, lodRecords.data(), lodRecords.size() * sizeof(LodRecord));
+        objects.push_back(object);
+    }
+
+    FileHeader header{};
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.sourceSize = stamp.size;
+    header.sourceTime = stamp.time;
+    header.sourceHash = stamp.hash;
+    header.objectCount = static_cast<uint32_t>(objects.size());
+    header.flags = stamp.flags;
+    header.objectTableOffset = appendBlock(out, objects.data(), objects.size() * sizeof(ObjectRecord));
+    memcpy(out.data(), &header, sizeof(FileHeader));
+
+    fs::path temp = path;
+    temp += ".tmp";
+    {
+        ofstream file(temp, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            glog.log<DefaultLevel::Warn>("预处理网格缓存无法写出: " + temp.string());
+            return false;
+        }
+        file.write(out.data(), static_cast<streamsize>(out.size()));
+        if (!file.good()) {
+            glog.log<DefaultLevel::Warn>("预处理网格缓存写出失败: " + temp.string());
+            return false;
+        }
+    }
+    error_code ec;
+    fs::rename(temp, path, ec);
+    if (ec) {
+        glog.log<DefaultLevel::Warn>("预处理网格缓存替换失败: " + path.string());
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool MeshCache::refreshStamp(const std::filesystem::path &path, const SourceStamp &stamp) {
+    fstream file(path, ios::binary | ios::in | ios::out);
+    if (!file.is_open()) return false;
+    FileHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+    if (!file.good() || memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version) return false;
+    header.sourceSize = stamp.size;
+    header.sourceTime = stamp.time;
+    header.sourceHash = stamp.hash;
+    header.flags |= stamp.flags;
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+    return file.good();
+}
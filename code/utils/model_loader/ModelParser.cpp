@@ -1,16 +1,296 @@
 #include "ModelParser.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
 #include <sstream>
 
 #include <GlobalLogger.hpp>
+#include <MappedFile.hpp>
+#include <MeshOptimizer.h>
+#include <StaticVertexFormat.hpp>
 
 using namespace std;
+namespace fs = std::filesystem;
 
-std::map<std::string, VertexLayout<float> > ModelParser::ObjModelLoader(const std::string &source) {
+std::map<std::string, VertexLayout<float> > ModelParser::ObjModelLoader(const std::string &source, ObjBackend backend, bool optimize) {
     if (source.empty()) {
         glog.log<DefaultLevel::Error>("错误: obj模型源为空");
         std::terminate();
     }
-    return ObjModelLoader::parser(source);
+    auto models = backend == ObjBackend::Stream ? ObjModelLoader::parser(source) : parseView(source, backend);
+    if (optimize) {
+        optimizeModels(models);
+    }
+    return models;
+}
+
+std::map<std::string, VertexLayout<float> > ModelParser::ObjModelLoader(const std::filesystem::path &path, ObjBackend backend, bool optimize) {
+    const MappedFile file(path);
+    if (file.empty()) {
+        glog.log<DefaultLevel::Error>("错误: obj模型文件为空或无法映射: " + path.string());
+        std::terminate();
+    }
+    auto models = parseView(file.view(), backend);
+    if (optimize) {
+        optimizeModels(models);
+    }
+    return models;
+}
+
+std::map<std::string, VertexLayout<float> > ModelParser::ObjModelLoader(const std::filesystem::path &path, MaterialLibrary &materials,
+    std::map<std::string, std::vector<Submesh>> &submeshes, ObjBackend backend) {
+    const MappedFile file(path);
+    if (file.empty()) {
+        glog.log<DefaultLevel::Error>("错误: obj模型文件为空或无法映射: " + path.string());
+        std::terminate();
+    }
+    if (backend == ObjBackend::Stream) {
+        glog.log<DefaultLevel::Warn>("Stream 后端不支持材质解析, 改用 Scan 后端: " + path.string());
+        backend = ObjBackend::Scan;
+    }
+    MaterialContext context{&materials, &submeshes, {}};
+    auto models = parseView(file.view(), backend, &context);
+
+    bool loaded{false};
+    for (const auto& e : context.libraries) {
+        const fs::path library = path.parent_path() / fs::path(e);
+        if (fs::exists(library)) {
+            loaded = materials.load(library) || loaded;
+        } else {
+            glog.log<DefaultLevel::Warn>("mtl文件不存在: " + library.string());
+        }
+    }
+    // 导出工具常写错 mtllib 文件名, 此时回退到与obj同名的 mtl
+    if (!loaded) {
+        const fs::path fallback = fs::path(path).replace_extension(".mtl");
+        if (fs::exists(fallback)) {
+            materials.load(fallback);
+        }
+    }
+    return models;
+}
+
+std::map<std::string, VertexLayout<float> > ModelParser::CookedObjModelLoader(const std::filesystem::path &path, ObjBackend backend, bool optimize) {
+    return cookedLoad(path, backend, optimize, nullptr, nullptr);
+}
+
+MeshCache::CookedMesh ModelParser::CookedObjModelMapping(const std::filesystem::path &path, ObjBackend backend, bool optimize) {
+    const fs::path cache = MeshCache::cachePath(path);
+    MeshCache::SourceStamp stamp = MeshCache::stamp(path);
+    stamp.flags = optimize ? MeshCache::flagOptimized : 0;
+    {
+        MeshCache::CookedMesh cooked(cache);
+        if (cooked.matches(stamp)) {
+            return cooked;
+        }
+    }
+    // 重新解析或仅刷新源文件戳都须先释放映射, 完成后再映射一次
+    cookedLoad(path, backend, optimize, nullptr, nullptr);
+    return MeshCache::CookedMesh(cache);
+}
+
+std::map<std::string, VertexLayout<float> > ModelParser::CookedObjModelLoader(const std::filesystem::path &path, std::map<std::string, std::vector<MeshSimplifier::Lod>> &lods,
+    const std::vector<float> &ratios, ObjBackend backend, bool optimize) {
+    return cookedLoad(path, backend, optimize, &ratios, &lods);
+}
+
+std::map<std::string, VertexLayout<float> > ModelParser::cookedLoad(const std::filesystem::path &path, ObjBackend backend, bool optimize,
+    const std::vector<float> *ratios, std::map<std::string, std::vector<MeshSimplifier::Lod>> *lods) {
+    const fs::path cache = MeshCache::cachePath(path);
+    MeshCache::SourceStamp stamp = MeshCache::stamp(path);
+    stamp.flags = (optimize ? MeshCache::flagOptimized : 0) | (ratios != nullptr ? MeshCache::flagLods : 0);
+    {
+        std::map<std::string, VertexLayout<float>> models{};
+        {
+            const MeshCache::CookedMesh cooked(cache);
+            // 细节层次比例与请求不一致时同样视为失效
+            auto usable = [&] {
+                return cooked.matches(stamp) && (ratios == nullptr || cooked.hasLods(*ratios));
+            };
+            auto take = [&] {
+                if (lods != nullptr) {
+                    *lods = cooked.toLods();
+                }
+                return cooked.toLayouts();
+            };
+            if (usable()) {
+                return take();
+            }
+            // 修改时间变化但大小一致时比对内容哈希
+            if (cooked.valid() && cooked.header().sourceSize == stamp.size) {
+                const MappedFile file(path);
+                stamp.hash = MeshCache::hash(file.view());
+                if (usable()) {
+                    models = take();
+                }
+            }
+        }
+        // 内容未变, 刷新缓存中的修改时间以免下次再次计算哈希
+        if (!models.empty()) {
+            MeshCache::refreshStamp(cache, stamp);
+            return models;
+        }
+    }
+
+    const MappedFile file(path);
+    if (file.empty()) {
+        glog.log<DefaultLevel::Error>("错误: obj模型文件为空或无法映射: " + path.string());
+        std::terminate();
+    }
+    auto models = parseView(file.view(), backend);
+    if (optimize) {
+        optimizeModels(models);
+    }
+    std::map<std::string, std::vector<MeshSimplifier::Lod>> chains{};
+    if (ratios != nullptr) {
+        for (const auto& [name, layout] : models) {
+            if (layout.rawIndices().empty()) continue;
+            auto chain = MeshSimplifier::buildLodChain(layout, *ratios);
+            if (optimize) {
+                const size_t vertexCount = layout.WeldIndices().size() / (layout.elements()[0].step / sizeof(float));
+                for (auto& e : chain) {
+                    e.indices = MeshOptimizer::optimizeOverdraw(MeshOptimizer::optimizeVertexCache(e.indices, vertexCount), layout);
+                }
+            }
+            chains.emplace(name, std::move(chain));
+        }
+    }
+    if (stamp.hash == 0) {
+        stamp.hash = MeshCache::hash(file.view());
+    }
+    if (!MeshCache::write(cache, stamp, models, chains)) {
+        glog.log<DefaultLevel::Warn>("预处理网格缓存写出失败, 下次加载将重新解析: " + path.string());
+    }
+    if (lods != nullptr) {
+        *lods = std::move(chains);
+    }
+    return models;
+}
+
+bool ModelParser::ObjStreamLoader(std::istream &source, const ObjectCallback &callback, size_t bufferSize) {
+    return ObjScanLoader::streamParser(source, callback, bufferSize);
+}
+
+bool ModelParser::ObjStreamLoader(const std::filesystem::path &path, const ObjectCallback &callback, size_t bufferSize) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) {
+        glog.log<DefaultLevel::Warn>("错误: obj模型文件无法打开: " + path.string());
+        return false;
+    }
+    return ObjScanLoader::streamParser(file, callback, bufferSize);
+}
+
+void ModelParser::parallelThreads(size_t threads) {
+    threadCount.store(threads, std::memory_order_relaxed);
+}
+
+void ModelParser::optimizeModels(std::map<std::string, VertexLayout<float>> &models) {
+    for (auto& [name, layout] : models) {
+        const auto report = MeshOptimizer::optimize(layout);
+        glog.logf<DefaultLevel::Debug>("网格优化[{}]: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+            name, report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr);
+    }
+}
+
+std::map<std::string, VertexLayout<float> > ModelParser::parseView(std::string_view source, ObjBackend backend, MaterialContext* materials) {
+    switch (backend) {
+        case ObjBackend::Stream: return ObjModelLoader::parser(string(source));
+        case ObjBackend::Scan: return ObjScanLoader::parser(source, materials);
+        case ObjBackend::ParallelScan: return ObjScanLoader::parallelParser(source, threadCount.load(std::memory_order_relaxed), materials);
+    }
+    return ObjScanLoader::parser(source, materials);
+}
+
+std::vector<Submesh> ModelParser::groupByMaterial(ObjectBuffer &buffer, const std::string &inherited, MaterialContext &materials) {
+    vector<Submesh> out{};
+    auto& indices = buffer.indices;
+    // 每个面角写出的索引数即面角形式中存在的元素数
+    const size_t corner = static_cast<size_t>(popcount(buffer.mask));
+    if (indices.empty() || corner == 0) return out;
+
+    struct Run {
+        uint32_t material;
+        size_t begin;
+        size_t end;
+    };
+    auto idOf = [&](const string& name) {
+        return name.empty() ? MaterialLibrary::invalidId : materials.library->intern(name);
+    };
+    vector<Run> runs{};
+    uint32_t material = idOf(inherited);
+    size_t begin{0};
+    for (const auto& e : buffer.materials) {
+        if (e.indexStart != begin) {
+            runs.push_back(Run{material, begin, e.indexStart});
+        }
+        material = idOf(e.name);
+        begin = e.indexStart;
+    }
+    if (begin != indices.size()) {
+        runs.push_back(Run{material, begin, indices.size()});
+    }
+
+    // 按材质首次出现的顺序稳定归并, 区间本已按材质连续时不搬动索引
+    vector<uint32_t> order{};
+    for (const auto& e : runs) {
+        if (find(order.begin(), order.end(), e.material) == order.end()) {
+            order.push_back(e.material);
+        }
+    }
+    vector<unsigned int> grouped{};
+    const bool contiguous = order.size() == runs.size() || ranges::is_sorted(runs, {}, [&](const Run& e) {
+        return find(order.begin(), order.end(), e.material) - order.begin();
+    });
+    if (!contiguous) {
+        grouped.reserve(indices.size());
+    }
+    size_t offset{0};
+    for (const uint32_t id : order) {
+        size_t count{0};
+        for (const auto& e : runs) {
+            if (e.material != id) continue;
+            if (!contiguous) {
+                grouped.insert(grouped.end(), indices.begin() + static_cast<ptrdiff_t>(e.begin), indices.begin() + static_cast<ptrdiff_t>(e.end));
+            }
+            count += e.end - e.begin;
+        }
+        out.push_back(Submesh{id, static_cast<uint32_t>(offset / corner), static_cast<uint32_t>(count / corner)});
+        offset += count;
+    }
+    if (!contiguous) {
+        indices = std::move(grouped);
+    }
+    return out;
+}
+
+VertexLayout<float> ModelParser::assembleLayout(ObjectBuffer &buffer) {
+    auto builder = VertexLayout<float>::builder();
+    // 没有面时保留全部元素, 否则只保留面角引用的元素
+    const unsigned int mask = buffer.mask == 0 ? 0b111u : buffer.mask;
+    if (!buffer.vertices.empty() && (mask & 1u)) {
+        buffer.vertices.shrink_to_fit();
+        builder.appendElement("vertices", 3)
+            .attachSource("vertices", std::move(buffer.vertices));
+    }
+    if (!buffer.texCoord.empty() && (mask & 2u)) {
+        buffer.texCoord.shrink_to_fit();
+        builder.appendElement("texCoord", 2)
+            .attachSource("texCoord", std::move(buffer.texCoord));
+    }
+    if (!buffer.normal.empty() && (mask & 4u)) {
+        buffer.normal.shrink_to_fit();
+        builder.appendElement("normal", 3)
+            .attachSource("normal", std::move(buffer.normal));
+    }
+    if (!buffer.indices.empty()) {
+        builder.attachIndices(std::move(buffer.indices));
+    }
+    buffer = ObjectBuffer{};
+    auto layout = builder.build();
+    if (vertex_format::PositionTexCoordNormal::matches(layout)) {
+        layout.bindFormat<vertex_format::PositionTexCoordNormal>();
+    }
+    return layout;
 }
 
 std::map<std::string, VertexLayout<float> > ModelParser::ObjModelLoader::parser(const std::string &source) {
@@ -21,59 +301,48 @@ std::map<std::string, VertexLayout<float> > ModelParser::ObjModelLoader::parser(
     while (getline(sourceIss, line)) {
         if (line[0] == '#' || line.empty()) continue;
         if (line[0] == 'o') {
-            objectProcess(line.substr(2), sourceIss, models, v_size, t_size, n_size);
+            string name = line.substr(2);
+            while (objectProcess(name, sourceIss, models, v_size, t_size, n_size)) {}
         }
     }
     return models;
 }
 
-void ModelParser::ObjModelLoader::objectProcess(const string& name, istringstream &source, std::map<std::string, VertexLayout<float>>& models, VertexCounter& v, VertexCounter& t, VertexCounter& n) {
-    auto builder = VertexLayout<float>::builder();
-    vector<float> vertices{};
-    vector<float> texCoord{};
-    vector<float> normal{};
-    vector<unsigned int> indices;
+bool ModelParser::ObjModelLoader::objectProcess(string& name, istringstream &source, std::map<std::string, VertexLayout<float>>& models, VertexCounter& v, VertexCounter& t, VertexCounter& n) {
+    ObjectBuffer buffer{};
 
     VertexCounter local_v{0, v.count}, local_t{0, t.count}, local_n{0, n.count};
 
     string line;
+    bool hasNext{false};
     while (getline(source, line)) {
         if (line[0] == '#' || line.empty()) continue;
         if (line[0] == 'o') {
-            v.start += local_v.count;
-            v.count += local_v.count;
-            t.start += local_t.count;
-            t.count += local_t.count;
-            n.start += local_n.count;
-            n.count += local_n.count;
-
-            objectProcess(line.substr(2), source, models, v, t, n);
+            hasNext = true;
             break;
         }
-        lineProcess(line, vertices, texCoord, normal, indices, local_v, local_t, local_n);
-    }
-    if (!vertices.empty()) {
-        vertices.shrink_to_fit();
-        builder.appendElement("vertices", 3)
-            .attachSource("vertices", std::move(vertices));
-    }
-    if (!texCoord.empty()) {
-        texCoord.shrink_to_fit();
-        builder.appendElement("texCoord", 2)
-            .attachSource("texCoord", std::move(texCoord));
-    }
-    if (!normal.empty()) {
-        normal.shrink_to_fit();
-        builder.appendElement("normal", 3)
-            .attachSource("normal", std::move(normal));
+        lineProcess(line, buffer, local_v, local_t, local_n);
     }
-    if (!indices.empty()) {
-        builder.attachIndices(std::move(indices));
+    v.start += local_v.count;
+    v.count += local_v.count;
+    t.start += local_t.count;
+    t.count += local_t.count;
+    n.start += local_n.count;
+    n.count += local_n.count;
+
+    // 同名对象以最后出现者为准
+    resolveFaces(buffer, name);
+    models.insert_or_assign(name, assembleLayout(buffer));
+    if (hasNext) {
+        name = line.substr(2);
     }
-    models.emplace(name, std::move(builder.build()));
+    return hasNext;
 }
 
-void ModelParser::ObjModelLoader::lineProcess(const std::string &line, vector<float>& vertices, vector<float>& texCoord, vector<float>& normal, vector<unsigned int> &indices, VertexCounter& v, VertexCounter& t, VertexCounter& n) {
+void ModelParser::ObjModelLoader::lineProcess(const std::string &line, ObjectBuffer& buffer, VertexCounter& v, VertexCounter& t, VertexCounter& n) {
+    auto& vertices = buffer.vertices;
+    auto& texCoord = buffer.texCoord;
+    auto& normal = buffer.normal;
     istringstream lineIss(line);
     string token;
     while (getline(lineIss, token, ' ')) {
@@ -101,30 +370,9 @@ void ModelParser::ObjModelLoader::lineProcess(const std::string &line, vector<fl
             n.count++;
         }
         else if (token == "f") {  // 面
-            string fLine;
-            while (getline(lineIss, token, ' ')) {
-                string index;
-                istringstream tokenIss(token);
-                size_t counterIndex{0};
-                while (getline(tokenIss, index, '/')) {
-                    switch (counterIndex) {
-                        case 0: {
-                            indices.push_back(stoull(index) - 1 - v.start);
-                            break;
-                        }
-                        case 1: {
-                            indices.push_back(stoull(index) - 1 - t.start);
-                            break;
-                        }
-                        case 2: {
-                            indices.push_back(stoull(index) - 1 - n.start);
-                            break;
-                        }
-                        default: break;
-                    }
-                    counterIndex++;
-                }
-            }
+            string record;
+            getline(lineIss, record);
+            faceProcess(record, buffer, {v.start, t.start, n.start}, {v.start + v.count, t.start + t.count, n.start + n.count});
         }
     }
 }
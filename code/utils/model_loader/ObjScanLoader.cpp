@@ -0,0 +1,673 @@
+#include "ModelParser.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <thread>
+
+#include <GlobalLogger.hpp>
+
+using namespace std;
+
+namespace {
+    inline bool isBlank(const char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline const char* skipBlank(const char* cursor, const char* end) {
+        while (cursor != end && isBlank(*cursor)) cursor++;
+        return cursor;
+    }
+
+    inline const char* skipToken(const char* cursor, const char* end) {
+        while (cursor != end && !isBlank(*cursor)) cursor++;
+        return cursor;
+    }
+
+    /**
+     * @brief 从游标处截取一行并推进游标
+     * @details 返回的行不含换行符与行尾的 '\r'
+     */
+    inline string_view nextLine(const char*& cursor, const char* end) {
+        const char* begin = cursor;
+        auto* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+            cursor = end;
+        } else {
+            cursor = lineEnd + 1;
+        }
+        if (lineEnd != begin && *(lineEnd - 1) == '\r') lineEnd--;
+        return {begin, static_cast<size_t>(lineEnd - begin)};
+    }
+
+    inline const char* parseFloat(const char* cursor, const char* end, float& out) {
+        cursor = skipBlank(cursor, end);
+        if (cursor != end && *cursor == '+') cursor++;
+        auto [ptr, ec] = from_chars(cursor, end, out);
+        if (ec != errc{}) {
+            out = 0.0f;
+            return skipToken(cursor, end);
+        }
+        return ptr;
+    }
+
+    /**
+     * @brief 解析面记录中的单个顶点引用并写出存在的槽位
+     * @details 支持 v, v/vt, v//vn, v/vt/vn 四种形式, 索引减去所属对象的起始偏移;
+     * 负索引相对当前已定义的数量解析[-1 为最后一个], 索引为 0, 落在所属对象之前或超出 32 位时视为无效;
+     * 正索引可引用尚未定义的元素, 此时置位 pending, 由对象结束时的越界检查处理
+     * @return 存在的槽位掩码[第 i 位对应 v/vt/vn, 格式错误时为 0]
+     */
+    inline unsigned int parseCorner(const char*& cursor, const char* end, vector<unsigned int>& indices, const size_t (&starts)[3], const size_t (&counts)[3],
+        bool& valid, bool& pending) {
+        unsigned int mask{0};
+        size_t slot{0};
+        while (cursor != end && !isBlank(*cursor)) {
+            if (*cursor == '/') {
+                slot++;
+                cursor++;
+                continue;
+            }
+            // 索引只有十进制整数, 逐位累加比 from_chars 更快
+            const bool negative = *cursor == '-';
+            const char* digits = cursor + negative;
+            size_t value{0};
+            for (cursor = digits; cursor != end && static_cast<unsigned char>(*cursor - '0') < 10; cursor++) {
+                value = value * 10 + static_cast<size_t>(*cursor - '0');
+            }
+            if (cursor == digits || slot >= 3) {
+                cursor = skipToken(cursor, end);
+                return 0;
+            }
+            // 以无符号回绕把三种无效情形[0, 落在对象之前, 负索引越界]归为一次比较
+            const size_t defined = counts[slot] - starts[slot];
+            const size_t local = negative ? defined - value : value - 1 - starts[slot];
+            valid &= local < (negative ? defined : min<size_t>(~starts[slot], numeric_limits<unsigned int>::max()));
+            pending |= local >= defined;
+            indices.push_back(static_cast<unsigned int>(local));
+            mask |= 1u << slot;
+        }
+        return mask;
+    }
+
+    /**
+     * @brief 解析面记录的全部面角
+     * @details 面角形式只按语法判定, 计数与解析共用, 保证两遍扫描对同一对象得到相同的面角形式
+     * @return 面角形式[各角形式不一致, 不足 3 个角或缺少顶点时为 0]
+     */
+    inline unsigned int parseFace(string_view record, vector<unsigned int>& indices, const size_t (&starts)[3], const size_t (&counts)[3],
+        size_t& count, bool& valid, bool& pending) {
+        const char* cursor = record.data();
+        const char* end = cursor + record.size();
+        unsigned int mask{0};
+        bool consistent{true};
+        while ((cursor = skipBlank(cursor, end)) != end) {
+            const unsigned int corner = parseCorner(cursor, end, indices, starts, counts, valid, pending);
+            if (count++ == 0) mask = corner;
+            // 面内各角的形式须一致, 否则写出的索引无法按元素数分组
+            consistent &= corner == mask;
+        }
+        return consistent && count >= 3 && (mask & 1u) != 0 ? mask : 0;
+    }
+
+    /**
+     * @brief 面记录的面角形式
+     * @details 他似乎不需要详细注释[划掉]
+     */
+    inline unsigned int faceMask(string_view record) {
+        thread_local vector<unsigned int> scratch{};
+        constexpr size_t zero[3]{};
+        scratch.clear();
+        size_t count{0};
+        bool valid{true}, pending{false};
+        return parseFace(record, scratch, zero, zero, count, valid, pending);
+    }
+
+    /**
+     * @brief 多边形三角化
+     * @details 投影到 Newell 法线的主平面后判断凹凸, 凸多边形按扇形展开, 凹多边形做耳切, 耳切无法继续时剩余部分退化为扇形;
+     * 调用方保证各面角的顶点位置均在 positions 内
+     * @param indices 索引, first 之后为多边形各面角的索引[每个面角 stride 个, 首个为顶点索引], 将被改写为三角形
+     * @param first 多边形的起始位置
+     * @param stride 每个面角的索引数
+     * @param count 面角数
+     * @param positions 对象的顶点位置
+     * @param base positions 首个元素对应的局部顶点索引
+     */
+    void triangulate(vector<unsigned int>& indices, const size_t first, const size_t stride, const size_t count, const vector<float>& positions, const size_t base) {
+        thread_local vector<unsigned int> corners{};
+        corners.assign(indices.begin() + static_cast<ptrdiff_t>(first), indices.end());
+        indices.resize(first);
+        auto emit = [&](const unsigned int a, const unsigned int b, const unsigned int c) {
+            for (const unsigned int e : {a, b, c}) {
+                indices.insert(indices.end(), corners.begin() + static_cast<ptrdiff_t>(e * stride), corners.begin() + static_cast<ptrdiff_t>((e + 1) * stride));
+            }
+        };
+        auto fan = [&](const vector<unsigned int>& polygon) {
+            for (size_t i = 1; i + 1 < polygon.size(); i++) {
+                emit(polygon[0], polygon[i], polygon[i + 1]);
+            }
+        };
+        thread_local vector<unsigned int> polygon{};
+        polygon.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            polygon[i] = static_cast<unsigned int>(i);
+        }
+
+        thread_local vector<float> points{};
+        points.resize(count * 3);
+        for (size_t i = 0; i < count; i++) {
+            copy_n(positions.data() + (corners[i * stride] - base) * 3, 3, points.data() + i * 3);
+        }
+        float normal[3]{};
+        for (size_t i = 0; i < count; i++) {
+            const float* a = points.data() + i * 3;
+            const float* b = points.data() + (i + 1) % count * 3;
+            normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+            normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+            normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+        }
+        // 丢弃法线的主分量所在轴, 并保证投影后为逆时针
+        size_t axis{0};
+        if (abs(normal[1]) > abs(normal[axis])) axis = 1;
+        if (abs(normal[2]) > abs(normal[axis])) axis = 2;
+        const size_t u = (axis + 1) % 3, w = (axis + 2) % 3;
+        const float sign = normal[axis] < 0.0f ? -1.0f : 1.0f;
+        auto cross = [&](const unsigned int a, const unsigned int b, const unsigned int c) {
+            const float* pa = points.data() + a * 3;
+            const float* pb = points.data() + b * 3;
+            const float* pc = points.data() + c * 3;
+            return sign * ((pb[u] - pa[u]) * (pc[w] - pa[w]) - (pb[w] - pa[w]) * (pc[u] - pa[u]));
+        };
+
+        bool convex{true};
+        for (size_t i = 0; i < count && convex; i++) {
+            convex = cross(polygon[i], polygon[(i + 1) % count], polygon[(i + 2) % count]) >= 0.0f;
+        }
+        if (convex) {
+            fan(polygon);
+            return;
+        }
+
+        while (polygon.size() > 3) {
+            const size_t size = polygon.size();
+            bool clipped{false};
+            for (size_t i = 0; i < size; i++) {
+                const unsigned int a = polygon[(i + size - 1) % size], b = polygon[i], c = polygon[(i + 1) % size];
+                if (cross(a, b, c) <= 0.0f) continue;
+                bool ear{true};
+                for (size_t j = 0; j < size && ear; j++) {
+                    const unsigned int p = polygon[j];
+                    if (p == a || p == b || p == c) continue;
+                    ear = !(cross(a, b, p) >= 0.0f && cross(b, c, p) >= 0.0f && cross(c, a, p) >= 0.0f);
+                }
+                if (!ear) continue;
+                emit(a, b, c);
+                polygon.erase(polygon.begin() + static_cast<ptrdiff_t>(i));
+                clipped = true;
+                break;
+            }
+            if (!clipped) break;
+        }
+        fan(polygon);
+    }
+
+    enum class RecordKind {
+        Other,
+        Vertex,
+        TexCoord,
+        Normal,
+        Face,
+        Material
+    };
+
+    /**
+     * @brief 截取行首记号并判定记录类型
+     * @details 计数与解析共用, 保证两遍扫描对同一行的判定一致
+     */
+    inline RecordKind recordKind(string_view line, const char*& cursor) {
+        const char* end = line.data() + line.size();
+        cursor = skipBlank(line.data(), end);
+        const char* keyEnd = skipToken(cursor, end);
+        const string_view key{cursor, static_cast<size_t>(keyEnd - cursor)};
+        cursor = keyEnd;
+        if (key == "v") return RecordKind::Vertex;
+        if (key == "vt") return RecordKind::TexCoord;
+        if (key == "vn") return RecordKind::Normal;
+        if (key == "f") return RecordKind::Face;
+        if (key == "usemtl") return RecordKind::Material;
+        return RecordKind::Other;
+    }
+
+    constexpr size_t minChunkSize = 1 << 20;
+
+    /**
+     * @brief 截取记号后的参数[去除首尾空白]
+     */
+    inline string_view argument(const char* cursor, const char* end) {
+        cursor = skipBlank(cursor, end);
+        while (end != cursor && isBlank(*(end - 1))) end--;
+        return {cursor, static_cast<size_t>(end - cursor)};
+    }
+
+    inline bool isLibrary(string_view line) {
+        return line.size() > 7 && line.substr(0, 6) == "mtllib" && isBlank(line[6]);
+    }
+
+    /**
+     * @brief 以 count 个线程并行执行 count 个任务, 调用线程承担第 0 个任务
+     */
+    template<typename Func>
+    void parallelFor(size_t count, Func&& func) {
+        vector<thread> workers{};
+        workers.reserve(count);
+        for (size_t i = 1; i < count; i++) {
+            workers.emplace_back(func, i);
+        }
+        if (count > 0) func(0);
+        for (auto& e : workers) {
+            e.join();
+        }
+    }
+}
+
+std::map<std::string, VertexLayout<float>> ModelParser::ObjScanLoader::parser(std::string_view source, MaterialContext* materials) {
+    map<string, VertexLayout<float>> models{};
+    vector<ObjSegment> segments{};
+    vector<string> libraries{};
+    chunkProcess(source, ScanState{}, segments, libraries);
+    mergeSegments(segments, models, materials);
+    if (materials != nullptr) {
+        materials->libraries = std::move(libraries);
+    }
+    return models;
+}
+
+std::map<std::string, VertexLayout<float>> ModelParser::ObjScanLoader::parallelParser(std::string_view source, size_t threads, MaterialContext* materials) {
+    if (threads == 0) {
+        threads = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+    threads = min(threads, source.size() / minChunkSize);
+    if (threads <= 1) {
+        return parser(source, materials);
+    }
+
+    // 在行边界处切分
+    vector<string_view> chunks{};
+    chunks.reserve(threads);
+    const size_t targetSize = source.size() / threads;
+    size_t begin{0};
+    while (begin < source.size()) {
+        size_t end = begin + targetSize;
+        if (chunks.size() + 1 == threads || end >= source.size()) {
+            end = source.size();
+        } else {
+            end = source.find('\n', end);
+            end = end == string_view::npos ? source.size() : end + 1;
+        }
+        chunks.push_back(source.substr(begin, end - begin));
+        begin = end;
+    }
+
+    // 第一遍: 统计各分块记录数
+    vector<ChunkCounter> counters(chunks.size());
+    parallelFor(chunks.size(), [&](size_t i) {
+        counters[i] = chunkCount(chunks[i]);
+    });
+
+    // 由前缀和得到各分块起始处的扫描状态, 面角形式随所在对象延续
+    vector<ScanState> states(chunks.size());
+    ScanState state{};
+    for (size_t i = 0; i < chunks.size(); i++) {
+        states[i] = state;
+        const auto& counter = counters[i];
+        VertexCounter* slots[3]{&state.v, &state.t, &state.n};
+        for (size_t k = 0; k < 3; k++) {
+            const size_t lead = state.inObject ? counter.lead[k] : 0;
+            if (counter.hasObject) {
+                slots[k]->start = slots[k]->count + lead + counter.lastObject[k];
+            }
+            slots[k]->count += lead + counter.tail[k];
+        }
+        if (counter.hasObject) {
+            state.mask = counter.tailMask;
+        } else if (state.inObject && state.mask == 0) {
+            state.mask = counter.leadMask;
+        }
+        state.inObject |= counter.hasObject;
+    }
+
+    // 第二遍: 并行解析到各自的片段缓冲
+    vector<vector<ObjSegment>> chunkSegments(chunks.size());
+    vector<vector<string>> chunkLibraries(chunks.size());
+    parallelFor(chunks.size(), [&](size_t i) {
+        chunkProcess(chunks[i], states[i], chunkSegments[i], chunkLibraries[i]);
+    });
+
+    vector<ObjSegment> segments{};
+    for (auto& e : chunkSegments) {
+        segments.insert(segments.end(), make_move_iterator(e.begin()), make_move_iterator(e.end()));
+    }
+    map<string, VertexLayout<float>> models{};
+    mergeSegments(segments, models, materials);
+    if (materials != nullptr) {
+        for (auto& e : chunkLibraries) {
+            materials->libraries.insert(materials->libraries.end(), make_move_iterator(e.begin()), make_move_iterator(e.end()));
+        }
+    }
+    return models;
+}
+
+void ModelParser::ObjScanLoader::chunkProcess(std::string_view chunk, ScanState state, std::vector<ObjSegment> &segments, std::vector<std::string> &libraries) {
+    if (state.inObject) {
+        segments.push_back(ObjSegment{true, {}, {}});
+        segments.back().buffer.mask = state.mask;
+    }
+    const char* cursor = chunk.data();
+    const char* end = cursor + chunk.size();
+    while (cursor != end) {
+        string_view line = nextLine(cursor, end);
+        if (line.empty() || line[0] == '#') continue;
+        if (line[0] == 'o') {
+            segments.push_back(ObjSegment{false, line.size() > 2 ? string(line.substr(2)) : string{}, {}});
+            state.v.start = state.v.count;
+            state.t.start = state.t.count;
+            state.n.start = state.n.count;
+            state.inObject = true;
+            continue;
+        }
+        if (line[0] == 'm' && isLibrary(line)) {
+            libraries.emplace_back(argument(line.data() + 6, line.data() + line.size()));
+            continue;
+        }
+        if (!state.inObject) continue;
+        lineProcess(line, segments.back().buffer, state.v, state.t, state.n);
+    }
+}
+
+ModelParser::ChunkCounter ModelParser::ObjScanLoader::chunkCount(std::string_view chunk) {
+    ChunkCounter counter{};
+    const char* cursor = chunk.data();
+    const char* end = cursor + chunk.size();
+    while (cursor != end) {
+        string_view line = nextLine(cursor, end);
+        if (line.empty() || line[0] == '#') continue;
+        if (line[0] == 'o') {
+            counter.hasObject = true;
+            copy_n(counter.tail, 3, counter.lastObject);
+            counter.tailMask = 0;
+            continue;
+        }
+        const char* rest{};
+        size_t* counts = counter.hasObject ? counter.tail : counter.lead;
+        unsigned int& mask = counter.hasObject ? counter.tailMask : counter.leadMask;
+        switch (recordKind(line, rest)) {
+            case RecordKind::Vertex: counts[0]++; break;
+            case RecordKind::TexCoord: counts[1]++; break;
+            case RecordKind::Normal: counts[2]++; break;
+            case RecordKind::Face: {
+                // 只需每个对象首个形式合法的面
+                if (mask == 0) {
+                    mask = faceMask({rest, static_cast<size_t>(line.data() + line.size() - rest)});
+                }
+                break;
+            }
+            default: break;
+        }
+    }
+    return counter;
+}
+
+void ModelParser::ObjScanLoader::mergeSegments(std::vector<ObjSegment> &segments, std::map<std::string, VertexLayout<float>> &models, MaterialContext* materials) {
+    auto append = []<typename T>(vector<T>& target, vector<T>& source) {
+        if (target.empty()) {
+            target = std::move(source);
+        } else {
+            target.insert(target.end(), make_move_iterator(source.begin()), make_move_iterator(source.end()));
+        }
+    };
+
+    // usemtl 状态按源顺序延续, inherited 为当前对象开始时生效的材质
+    string inherited{};
+    string active{};
+    ObjSegment* current{nullptr};
+    auto finish = [&] {
+        resolveFaces(current->buffer, current->name);
+        if (!current->buffer.materials.empty()) {
+            active = current->buffer.materials.back().name;
+        }
+        if (materials != nullptr) {
+            auto submeshes = groupByMaterial(current->buffer, inherited, *materials);
+            materials->submeshes->insert_or_assign(current->name, std::move(submeshes));
+        }
+        models.insert_or_assign(std::move(current->name), assembleLayout(current->buffer));
+    };
+    for (auto& e : segments) {
+        if (e.continuation) {
+            if (current == nullptr) continue;
+            const size_t offset = current->buffer.indices.size();
+            for (auto& run : e.buffer.materials) {
+                run.indexStart += offset;
+            }
+            for (auto& face : e.buffer.deferred) {
+                face.first += offset;
+            }
+            if (current->buffer.mask == 0) {
+                current->buffer.mask = e.buffer.mask;
+            }
+            current->buffer.mismatched += e.buffer.mismatched;
+            current->buffer.outOfRange += e.buffer.outOfRange;
+            append(current->buffer.vertices, e.buffer.vertices);
+            append(current->buffer.texCoord, e.buffer.texCoord);
+            append(current->buffer.normal, e.buffer.normal);
+            append(current->buffer.indices, e.buffer.indices);
+            append(current->buffer.materials, e.buffer.materials);
+            append(current->buffer.deferred, e.buffer.deferred);
+            e.buffer = ObjectBuffer{};
+            continue;
+        }
+        // 同名对象以最后出现者为准, 与 Stream 后端保持一致
+        if (current != nullptr) {
+            finish();
+            inherited = active;
+        }
+        current = &e;
+    }
+    if (current != nullptr) {
+        finish();
+    }
+    segments.clear();
+}
+
+bool ModelParser::ObjScanLoader::streamParser(std::istream &source, const ObjectCallback &callback, size_t bufferSize) {
+    vector<char> buffer(max<size_t>(bufferSize, 1));
+    size_t filled{0};
+    ScanState state{};
+    ObjSegment current{};
+    auto emit = [&] {
+        resolveFaces(current.buffer, current.name);
+        return callback(std::move(current.name), assembleLayout(current.buffer));
+    };
+
+    bool finished{false};
+    while (!finished) {
+        if (filled == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        source.read(buffer.data() + filled, static_cast<streamsize>(buffer.size() - filled));
+        filled += static_cast<size_t>(source.gcount());
+        finished = !source;
+        if (finished && source.bad()) {
+            glog.log<DefaultLevel::Warn>("错误: obj模型流读取失败");
+            return false;
+        }
+
+        // 仅处理到最后一个换行符为止, 流结束时处理全部剩余内容
+        const char* begin = buffer.data();
+        const char* limit = begin + filled;
+        if (!finished) {
+            while (limit != begin && *(limit - 1) != '\n') limit--;
+            if (limit == begin) continue;
+        }
+        const char* cursor = begin;
+        while (cursor != limit) {
+            string_view line = nextLine(cursor, limit);
+            if (line.empty() || line[0] == '#') continue;
+            if (line[0] == 'o') {
+                if (state.inObject && !emit()) return false;
+                current = ObjSegment{false, line.size() > 2 ? string(line.substr(2)) : string{}, {}};
+                state.v.start = state.v.count;
+                state.t.start = state.t.count;
+                state.n.start = state.n.count;
+                state.inObject = true;
+                continue;
+            }
+            if (!state.inObject) continue;
+            lineProcess(line, current.buffer, state.v, state.t, state.n);
+        }
+        filled = static_cast<size_t>(begin + filled - limit);
+        memmove(buffer.data(), limit, filled);
+    }
+    return !state.inObject || emit();
+}
+
+void ModelParser::ObjScanLoader::lineProcess(std::string_view line, ObjectBuffer &buffer, VertexCounter &v, VertexCounter &t, VertexCounter &n) {
+    const char* end = line.data() + line.size();
+    const char* cursor{};
+
+    switch (recordKind(line, cursor)) {
+        case RecordKind::Vertex: {  // 顶点坐标
+            float x, y, z;
+            cursor = parseFloat(cursor, end, x);
+            cursor = parseFloat(cursor, end, y);
+            parseFloat(cursor, end, z);
+            buffer.vertices.insert(buffer.vertices.end(), {x, y, z});
+            v.count++;
+            break;
+        }
+        case RecordKind::TexCoord: {  // 纹理坐标
+            float vertex_u, vertex_v;
+            cursor = parseFloat(cursor, end, vertex_u);
+            parseFloat(cursor, end, vertex_v);
+            buffer.texCoord.insert(buffer.texCoord.end(), {vertex_u, vertex_v});
+            t.count++;
+            break;
+        }
+        case RecordKind::Normal: {  // 法线
+            float x, y, z;
+            cursor = parseFloat(cursor, end, x);
+            cursor = parseFloat(cursor, end, y);
+            parseFloat(cursor, end, z);
+            buffer.normal.insert(buffer.normal.end(), {x, y, z});
+            n.count++;
+            break;
+        }
+        case RecordKind::Face: {  // 面
+            faceProcess({cursor, static_cast<size_t>(end - cursor)}, buffer, {v.start, t.start, n.start}, {v.count, t.count, n.count});
+            break;
+        }
+        case RecordKind::Material: {  // 材质
+            buffer.materials.push_back(MaterialRun{string(argument(cursor, end)), buffer.indices.size()});
+            break;
+        }
+        default: break;
+    }
+}
+
+void ModelParser::faceProcess(std::string_view record, ObjectBuffer &buffer, const size_t (&starts)[3], const size_t (&counts)[3]) {
+    auto& indices = buffer.indices;
+    // 先按三角形直接写出, 多边形与无效的面再回退改写
+    const size_t first = indices.size();
+    size_t count{0};
+    bool valid{true}, pending{false};
+    const unsigned int mask = parseFace(record, indices, starts, counts, count, valid, pending);
+    if (mask == 0) {
+        indices.resize(first);
+        return;
+    }
+    // 对象内各面的形式须一致, 否则面角索引无法与布局的元素对齐
+    if (buffer.mask == 0) {
+        buffer.mask = mask;
+    }
+    if (mask != buffer.mask || !valid) {
+        (mask != buffer.mask ? buffer.mismatched : buffer.outOfRange)++;
+        indices.resize(first);
+        return;
+    }
+    if (count == 3 && !pending) return;
+
+    // 分块解析的延续片段只持有本块内的顶点, base 为其首个顶点的局部索引
+    const size_t stride = static_cast<size_t>(popcount(mask));
+    const size_t base = counts[0] - starts[0] - buffer.vertices.size() / 3;
+    for (size_t i = 0; i < count && !pending; i++) {
+        pending = indices[first + i * stride] < base;
+    }
+    if (pending) {
+        buffer.deferred.push_back(DeferredFace{first, count});
+        return;
+    }
+    triangulate(indices, first, stride, count, buffer.vertices, base);
+}
+
+void ModelParser::resolveFaces(ObjectBuffer &buffer, const std::string &name) {
+    if (!buffer.deferred.empty()) {
+        resolveDeferred(buffer);
+    }
+    if (buffer.mismatched != 0 || buffer.outOfRange != 0) {
+        glog.logf<DefaultLevel::Warn>("错误: obj对象[{}]中 {} 个面的面角形式与首个面不一致, {} 个面的索引无效或越界, 均已丢弃",
+            name, buffer.mismatched, buffer.outOfRange);
+    }
+    buffer.mismatched = 0;
+    buffer.outOfRange = 0;
+}
+
+void ModelParser::resolveDeferred(ObjectBuffer &buffer) {
+    const size_t stride = static_cast<size_t>(popcount(buffer.mask));
+    // 按面角内的顺序排列各存在元素的数量
+    size_t limits[3]{};
+    size_t slot{0};
+    const size_t sizes[3]{buffer.vertices.size() / 3, buffer.texCoord.size() / 2, buffer.normal.size() / 3};
+    for (size_t k = 0; k < 3; k++) {
+        if (buffer.mask & (1u << k)) {
+            limits[slot++] = sizes[k];
+        }
+    }
+
+    auto& indices = buffer.indices;
+    auto& runs = buffer.materials;
+    vector<unsigned int> out{};
+    out.reserve(indices.size() + buffer.deferred.size() * stride * 3);
+    size_t copied{0}, run{0};
+    // 拷贝到 until 为止, 起点不晚于 until 的材质区间随之平移
+    auto flush = [&](const size_t until) {
+        for (; run < runs.size() && runs[run].indexStart <= until; run++) {
+            runs[run].indexStart = out.size() + (runs[run].indexStart - copied);
+        }
+        out.insert(out.end(), indices.begin() + static_cast<ptrdiff_t>(copied), indices.begin() + static_cast<ptrdiff_t>(until));
+        copied = until;
+    };
+    for (const auto& face : buffer.deferred) {
+        flush(face.first);
+        const size_t size = face.count * stride;
+        bool inside{true};
+        for (size_t i = 0; i < size && inside; i++) {
+            inside = indices[face.first + i] < limits[i % stride];
+        }
+        copied += size;
+        if (!inside) {
+            buffer.outOfRange++;
+            continue;
+        }
+        out.insert(out.end(), indices.begin() + static_cast<ptrdiff_t>(face.first), indices.begin() + static_cast<ptrdiff_t>(copied));
+        if (face.count > 3) {
+            triangulate(out, out.size() - size, stride, face.count, buffer.vertices, 0);
+        }
+    }
+    flush(indices.size());
+    indices = std::move(out);
+    buffer.deferred.clear();
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 材质
+ * @details 字段对应 mtl 中的同名记录, 未出现的记录保持默认值; 贴图路径已按 mtl 所在目录解析
+ */
+struct Material {
+    std::string name;
+    float ambient[3]{1.0f, 1.0f, 1.0f};     // Ka
+    float diffuse[3]{0.8f, 0.8f, 0.8f};     // Kd
+    float specular[3]{0.0f, 0.0f, 0.0f};    // Ks
+    float emissive[3]{0.0f, 0.0f, 0.0f};    // Ke
+    float shininess{0.0f};                  // Ns
+    float opticalDensity{1.0f};             // Ni
+    float dissolve{1.0f};                   // d[或 1 - Tr]
+    int illumination{2};                    // illum
+    std::string ambientMap;                 // map_Ka
+    std::string diffuseMap;                 // map_Kd
+    std::string specularMap;                // map_Ks
+    std::string normalMap;                  // map_Bump / bump / norm
+    std::string alphaMap;                   // map_d
+};
+
+/**
+ * @brief 子网格
+ * @details 对象内使用同一材质的连续索引区间, 以焊接组装后的索引[即面角]为单位
+ */
+struct Submesh {
+    uint32_t material;
+    uint32_t indexOffset;
+    uint32_t indexCount;
+};
+
+/**
+ * @brief 材质表
+ * @details 材质名驻留为连续的整数 ID, 渲染时按 ID 排序与合批; usemtl 引用但未在 mtl 中定义的材质以默认值占位
+ */
+class MaterialLibrary {
+    public:
+        static constexpr uint32_t invalidId{~0u};
+
+        MaterialLibrary() = default;
+        ~MaterialLibrary() = default;
+
+        /**
+         * @brief 驻留材质名
+         * @details 已存在时返回原 ID, 否则以默认值新建
+         * @param name 材质名
+         * @return 材质 ID
+         */
+        uint32_t intern(std::string_view name);
+
+        /**
+         * @brief 查找材质
+         * @details 他似乎不需要详细注释[划掉]
+         * @param name 材质名
+         * @return 材质 ID[不存在时为 invalidId]
+         */
+        [[nodiscard]] uint32_t find(std::string_view name) const;
+
+        /**
+         * @brief 解析 mtl 源
+         * @details 他似乎不需要详细注释[划掉]
+         * @param source mtl 源
+         * @param directory 贴图相对路径的基准目录
+         * @return 本次定义的材质数
+         */
+        size_t parse(std::string_view source, const std::filesystem::path& directory = {});
+
+        /**
+         * @brief 加载 mtl 文件
+         * @details 他似乎不需要详细注释[划掉]
+         * @param path mtl 文件路径
+         * @return 是否加载成功
+         */
+        bool load(const std::filesystem::path& path);
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] const std::vector<Material>& materials() const;
+
+        const Material& operator [] (uint32_t id) const;
+
+        Material& operator [] (uint32_t id);
+
+    private:
+        struct NameHash {
+            using is_transparent = void;
+            size_t operator () (std::string_view name) const {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
+
+        std::vector<Material> _materials;
+        std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> _ids;
+};
@@ -0,0 +1,211 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string_view>
+
+#include <MappedFile.hpp>
+#include <MeshSimplifier.h>
+#include <VertexLayout.hpp>
+
+/**
+ * @brief 预处理网格缓存
+ * @details 将解析后的缓冲区组装布局以二进制形式落盘, 文件内所有数据块按 16 字节对齐, 映射后可直接按视图使用;
+ * 细节层次的索引指向焊接后的顶点, 焊接结果由原始索引唯一确定, 因此与网格一同存放即可
+ */
+class MeshCache {
+    public:
+        static constexpr char magic[4]{'C', 'K', 'M', 'S'};
+        static constexpr uint32_t version{3};
+        static constexpr size_t alignment{16};
+        static constexpr uint32_t flagOptimized{1u << 0};    // 面已按顶点缓存与过度绘制重排
+        static constexpr uint32_t flagLods{1u << 1};         // 含细节层次链
+
+        /**
+         * @brief 源文件戳
+         * @details 大小与修改时间用于快速校验, 内容哈希用于修改时间变化但内容未变的情形, flags 为缓存须具备的处理标记
+         */
+        struct SourceStamp {
+            uint64_t size{};
+            int64_t time{};
+            uint64_t hash{};
+            uint32_t flags{};
+        };
+
+        /**
+         * @brief 文件头
+         */
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t sourceSize;
+            int64_t sourceTime;
+            uint64_t sourceHash;
+            uint32_t objectCount;
+            uint32_t flags;
+            uint64_t objectTableOffset;
+        };
+
+        /**
+         * @brief 对象描述
+         */
+        struct ObjectRecord {
+            uint64_t nameOffset;
+            uint32_t nameLength;
+            uint32_t elementCount;
+            uint64_t elementTableOffset;
+            uint64_t indicesOffset;
+            uint64_t indexCount;
+            uint64_t lodTableOffset;
+            uint32_t lodCount;
+            uint32_t reserved;
+        };
+
+        /**
+         * @brief 元素描述
+         */
+        struct ElementRecord {
+            uint64_t identifierOffset;
+            uint32_t identifierLength;
+            uint32_t length;
+            uint32_t location;
+            uint32_t reserved;
+            uint64_t sourceOffset;
+            uint64_t sourceCount;
+        };
+
+        /**
+         * @brief 细节层次描述
+         */
+        struct LodRecord {
+            float ratio;
+            float error;
+            uint64_t indicesOffset;
+            uint64_t indexCount;
+        };
+
+        /**
+         * @brief 映射后的预处理网格
+         * @details 持有文件映射, 所有视图在其生命周期内有效
+         */
+        class CookedMesh {
+            public:
+                struct ElementView {
+                    std::string_view identifier;
+                    uint32_t length;
+                    uint32_t location;
+                    std::span<const float> source;
+                };
+
+                struct LodView {
+                    float ratio;
+                    float error;
+                    std::span<const unsigned int> indices;
+                };
+
+                struct ObjectView {
+                    std::string_view name;
+                    std::vector<ElementView> elements;
+                    std::span<const unsigned int> indices;
+                    std::vector<LodView> lods;
+                };
+
+                CookedMesh() = default;
+
+                /**
+                 * @brief 映射并校验缓存文件
+                 * @details 结构不完整或版本不符时视为无效
+                 * @param path 缓存文件路径
+                 */
+                explicit CookedMesh(const std::filesystem::path& path);
+
+                [[nodiscard]] bool valid() const;
+
+                /**
+                 * @brief 缓存是否对应给定源文件
+                 * @details 须具备要求的处理标记, 大小与修改时间一致即命中, 否则比对内容哈希
+                 * @param stamp 源文件戳[hash 为 0 时仅比对大小与修改时间]
+                 * @return 他似乎不需要注释[划掉]
+                 */
+                [[nodiscard]] bool matches(const SourceStamp& stamp) const;
+
+                [[nodiscard]] const FileHeader& header() const;
+
+                [[nodiscard]] const std::vector<ObjectView>& objects() const;
+
+                /**
+                 * @brief 拷贝构建缓冲区组装布局表
+                 * @details 布局持有并可原位修改数据源, 拷贝是有意为之; 只需读取或上传时直接使用 objects() 中的视图
+                 * @return 以对象名为键的缓冲区组装布局表
+                 */
+                [[nodiscard]] std::map<std::string, VertexLayout<float>> toLayouts() const;
+
+                /**
+                 * @brief 各对象的细节层次比例是否均与给定比例一致
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @param ratios 各级目标三角形比例
+                 * @return 他似乎不需要注释[划掉]
+                 */
+                [[nodiscard]] bool hasLods(const std::vector<float>& ratios) const;
+
+                /**
+                 * @brief 拷贝构建细节层次链表
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @return 以对象名为键的细节层次链表
+                 */
+                [[nodiscard]] std::map<std::string, std::vector<MeshSimplifier::Lod>> toLods() const;
+
+            private:
+                MappedFile _file;
+                FileHeader _header{};
+                std::vector<ObjectView> _objects;
+                bool _isValid{false};
+        };
+
+        /**
+         * @brief 计算内容哈希
+         * @details 按 8 字节字长混合的 64 位哈希, 仅用于缓存失效判定
+         * @param content 内容
+         * @return 哈希值
+         */
+        static uint64_t hash(std::string_view content);
+
+        /**
+         * @brief 生成源文件戳
+         * @details 他似乎不需要详细注释[划掉]
+         * @param path 源文件路径
+         * @param content 源文件内容[为空时不计算哈希]
+         * @return 源文件戳
+         */
+        static SourceStamp stamp(const std::filesystem::path& path, std::string_view content = {});
+
+        /**
+         * @brief 默认缓存路径
+         * @details 源文件同目录下追加 .cooked 后缀
+         * @param source 源文件路径
+         * @return 缓存文件路径
+         */
+        static std::filesystem::path cachePath(const std::filesystem::path& source);
+
+        /**
+         * @brief 写出缓存文件
+         * @details 先写入临时文件再替换, 避免读到写了一半的缓存
+         * @param path 缓存文件路径
+         * @param stamp 源文件戳
+         * @param models 缓冲区组装布局表
+         * @param lods 以对象名为键的细节层次链表[可为空]
+         * @return 是否写出成功
+         */
+        static bool write(const std::filesystem::path& path, const SourceStamp& stamp, const std::map<std::string, VertexLayout<float>>& models,
+            const std::map<std::string, std::vector<MeshSimplifier::Lod>>& lods = {});
+
+        /**
+         * @brief 原位刷新缓存文件中的源文件戳
+         * @details 仅改写文件头, 调用前需释放对该缓存文件的映射
+         * @param path 缓存文件路径
+         * @param stamp 源文件戳
+         * @return 是否刷新成功
+         */
+        static bool refreshStamp(const std::filesystem::path& path, const SourceStamp& stamp);
+};
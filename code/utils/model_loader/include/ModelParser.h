@@ -1,20 +1,374 @@
 #pragma once
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <string_view>
+#include <vector>
+
+#include <MeshSimplifier.h>
 #include <VertexLayout.hpp>
 
+#include "MaterialLibrary.h"
+#include "MeshCache.h"
+
 class ModelParser {
     public:
+        /**
+         * @brief obj解析后端
+         */
+        enum class ObjBackend {
+            Stream,         // 基于 istringstream 的逐行解析
+            Scan,           // 基于 string_view 指针扫描与 from_chars 的单遍解析
+            ParallelScan    // 按行边界分块后多线程扫描解析, 结果与 Scan 逐位一致
+        };
+
+        /**
+         * @brief 流式解析的对象回调
+         * @details 每个对象块结束时调用一次, 返回 false 时停止解析
+         */
+        using ObjectCallback = std::function<bool(std::string name, VertexLayout<float> layout)>;
+
+        static constexpr size_t defaultStreamBufferSize{1 << 16};
+
         ~ModelParser() = default;
-        static std::map<std::string, VertexLayout<float>> ObjModelLoader(const std::string& source);
+
+        /**
+         * @brief 解析obj模型源
+         * @details 两种后端产出的结果完全一致, Stream 后端仅作为对照保留
+         * @param source obj模型源
+         * @param backend 解析后端
+         * @param optimize 是否在导入时进行网格优化[顶点缓存, 过度绘制与取顶点重排]
+         * @return 以对象名为键的缓冲区组装布局表
+         */
+        static std::map<std::string, VertexLayout<float>> ObjModelLoader(const std::string& source, ObjBackend backend = ObjBackend::Scan, bool optimize = false);
+
+        /**
+         * @brief 通过文件路径解析obj模型
+         * @details 文件以只读方式映射进内存并直接在映射页上解析, 不再整体拷贝进字符串, 解析完成后解除映射
+         * @param path obj文件路径
+         * @param backend 解析后端
+         * @param optimize 是否在导入时进行网格优化[顶点缓存, 过度绘制与取顶点重排]
+         * @return 以对象名为键的缓冲区组装布局表
+         */
+        static std::map<std::string, VertexLayout<float>> ObjModelLoader(const std::filesystem::path& path, ObjBackend backend = ObjBackend::Scan, bool optimize = false);
+
+        /**
+         * @brief 通过文件路径解析obj模型及其材质
+         * @details mtllib 相对obj所在目录解析, 找不到时回退到与obj同名的 .mtl; 各对象的面按材质首次出现的顺序稳定重排,
+         * 使每个材质在对象内只占一个连续区间; Stream 后端不支持材质, 将改用 Scan 后端
+         * @param path obj文件路径
+         * @param materials 材质表[新材质追加其后]
+         * @param submeshes 输出以对象名为键的子网格表
+         * @param backend 解析后端
+         * @return 以对象名为键的缓冲区组装布局表
+         */
+        static std::map<std::string, VertexLayout<float>> ObjModelLoader(const std::filesystem::path& path, MaterialLibrary& materials,
+            std::map<std::string, std::vector<Submesh>>& submeshes, ObjBackend backend = ObjBackend::Scan);
+
+        /**
+         * @brief 通过文件路径解析obj模型并使用预处理网格缓存
+         * @details 缓存位于源文件旁[.cooked], 源文件大小与修改时间未变或内容哈希一致时直接由缓存构建, 否则重新解析并回写缓存;
+         * 要求优化而缓存未经优化时同样视为失效; 布局持有并可原位修改数据源, 因此由映射拷贝而来, 只需读取时使用 CookedObjModelMapping
+         * @param path obj文件路径
+         * @param backend 缓存失效时使用的解析后端
+         * @param optimize 是否在导入时进行网格优化, 优化结果一并写入缓存
+         * @return 以对象名为键的缓冲区组装布局表
+         */
+        static std::map<std::string, VertexLayout<float>> CookedObjModelLoader(const std::filesystem::path& path, ObjBackend backend = ObjBackend::ParallelScan, bool optimize = false);
+
+        /**
+         * @brief 通过文件路径获取映射的预处理网格
+         * @details 缓存失效时先经 CookedObjModelLoader 解析并回写, 再重新映射; 各对象的元素源与索引视图直接指向映射页,
+         * 可不经拷贝直接上传, 在返回对象存续期间有效
+         * @param path obj文件路径
+         * @param backend 缓存失效时使用的解析后端
+         * @param optimize 是否在导入时进行网格优化
+         * @return 映射后的预处理网格[缓存无法写出时无效]
+         */
+        static MeshCache::CookedMesh CookedObjModelMapping(const std::filesystem::path& path, ObjBackend backend = ObjBackend::ParallelScan, bool optimize = false);
+
+        /**
+         * @brief 通过文件路径解析obj模型并生成细节层次链, 二者均使用预处理网格缓存
+         * @details 细节层次索引指向对应布局焊接组装后的顶点; 缓存中的细节层次比例与请求不一致时重新生成
+         * @param path obj文件路径
+         * @param lods 输出以对象名为键的细节层次链表
+         * @param ratios 各级目标三角形比例[递减]
+         * @param backend 缓存失效时使用的解析后端
+         * @param optimize 是否在导入时进行网格优化, 细节层次同样按顶点缓存与过度绘制重排
+         * @return 以对象名为键的缓冲区组装布局表
+         */
+        static std::map<std::string, VertexLayout<float>> CookedObjModelLoader(const std::filesystem::path& path, std::map<std::string, std::vector<MeshSimplifier::Lod>>& lods,
+            const std::vector<float>& ratios = {0.5f, 0.25f, 0.1f}, ObjBackend backend = ObjBackend::ParallelScan, bool optimize = false);
+
+        /**
+         * @brief 流式解析obj模型
+         * @details 以定长缓冲分段读取, 每个 o 对象块结束即构建其缓冲区组装布局并交给回调, 内存占用以最大的单个对象为上限;
+         * 与 Scan 后端逐对象一致, 但同名对象会各自回调一次; 单行长于缓冲时缓冲自动扩大
+         * @param source 输入流
+         * @param callback 对象回调
+         * @param bufferSize 读取缓冲大小
+         * @return 是否完整解析[回调要求停止或读取失败时为 false]
+         */
+        static bool ObjStreamLoader(std::istream& source, const ObjectCallback& callback, size_t bufferSize = defaultStreamBufferSize);
+
+        /**
+         * @brief 通过文件路径流式解析obj模型
+         * @details 他似乎不需要详细注释[划掉]
+         * @param path obj文件路径
+         * @param callback 对象回调
+         * @param bufferSize 读取缓冲大小
+         * @return 是否完整解析[回调要求停止或文件无法打开时为 false]
+         */
+        static bool ObjStreamLoader(const std::filesystem::path& path, const ObjectCallback& callback, size_t bufferSize = defaultStreamBufferSize);
+
+        /**
+         * @brief 设置 ParallelScan 后端的线程数
+         * @details 每个分块至少 1MB, 源过小时实际线程数相应减少
+         * @param threads 线程数[0 表示使用硬件并发数]
+         */
+        static void parallelThreads(size_t threads);
     private:
+        static inline std::atomic<size_t> threadCount{0};
+
+
         struct VertexCounter {
             size_t count;
             size_t start;
         };
+
+        /**
+         * @brief 材质区间起点
+         * @details usemtl 记录处的材质名与当时的原始索引数
+         */
+        struct MaterialRun {
+            std::string name;
+            size_t indexStart;
+        };
+
+        /**
+         * @brief 延后处理的面
+         * @details 引用了尚未定义的元素或位于前一分块的顶点, 原始面角索引保留在原位, 待对象结束时检查越界并三角化
+         */
+        struct DeferredFace {
+            size_t first;   // 在原始索引中的起始位置
+            size_t count;   // 面角数
+        };
+
+        /**
+         * @brief 单个对象的解析缓冲
+         * @details mask 由对象内首个形式合法的面确定, 之后形式不同的面被丢弃并计入 mismatched
+         */
+        struct ObjectBuffer {
+            std::vector<float> vertices;
+            std::vector<float> texCoord;
+            std::vector<float> normal;
+            std::vector<unsigned int> indices;
+            std::vector<MaterialRun> materials;
+            unsigned int mask{0};   // 面角形式[第 i 位对应 v/vt/vn]
+            std::vector<DeferredFace> deferred;
+            size_t mismatched{0};
+            size_t outOfRange{0};   // 含无效或越界引用而丢弃的面数
+        };
+
+        /**
+         * @brief 材质解析上下文
+         * @details 为空时解析结果与不处理材质时完全一致
+         */
+        struct MaterialContext {
+            MaterialLibrary* library;
+            std::map<std::string, std::vector<Submesh>>* submeshes;
+            std::vector<std::string> libraries;     // 按出现顺序的 mtllib 文件名
+        };
+
+        /**
+         * @brief 按后端解析源视图
+         * @details 他似乎不需要详细注释[划掉]
+         * @param source obj模型源
+         * @param backend 解析后端
+         * @return 以对象名为键的缓冲区组装布局表
+         */
+        static std::map<std::string, VertexLayout<float>> parseView(std::string_view source, ObjBackend backend, MaterialContext* materials = nullptr);
+
+        /**
+         * @brief 按材质稳定重排对象的面并生成子网格
+         * @details 首个 usemtl 之前的面沿用 inherited 材质; 材质区间不连续时才会重排原始索引
+         * @param buffer 解析缓冲
+         * @param inherited 对象开始时生效的材质名[为空表示无材质]
+         * @param materials 材质解析上下文
+         * @return 子网格
+         */
+        static std::vector<Submesh> groupByMaterial(ObjectBuffer& buffer, const std::string& inherited, MaterialContext& materials);
+
+        /**
+         * @brief 解码面记录并写出三角形索引
+         * @details 两种后端共用; 支持 v, v/vt, v//vn, v/vt/vn 与负索引, 多边形按扇形或耳切三角化;
+         * 面内各角形式不一致, 与对象的面角形式不一致或含无效引用时整个面被丢弃;
+         * 引用尚未定义的元素或顶点位置不在缓冲中的面延后到 resolveFaces 处理
+         * @param record f 记号之后的部分
+         * @param buffer 当前对象的解析缓冲
+         * @param starts 所属对象的 v/vt/vn 起始偏移
+         * @param counts 当前已定义的 v/vt/vn 数量
+         */
+        static void faceProcess(std::string_view record, ObjectBuffer& buffer, const size_t (&starts)[3], const size_t (&counts)[3]);
+
+        /**
+         * @brief 处理对象内延后的面
+         * @details 对象结束时调用, 此时缓冲持有对象的全部元素; 越界的面被丢弃, 多边形以全部顶点位置三角化, 材质区间起点随之平移;
+         * 有面被丢弃时输出一次警告
+         * @param buffer 解析缓冲
+         * @param name 对象名
+         */
+        static void resolveFaces(ObjectBuffer& buffer, const std::string& name);
+
+        /**
+         * @brief 检查并展开延后的面
+         * @details 他似乎不需要详细注释[划掉]
+         * @param buffer 解析缓冲[持有对象的全部元素]
+         */
+        static void resolveDeferred(ObjectBuffer& buffer);
+
+        /**
+         * @brief 由解析缓冲构建缓冲区组装布局
+         * @details 只包含面角形式中存在的元素, 使每个面角的索引数与元素数一致
+         * @param buffer 解析缓冲[数据将被移出]
+         * @return 缓冲区组装布局
+         */
+        static VertexLayout<float> assembleLayout(ObjectBuffer& buffer);
+
+        /**
+         * @brief 对全部对象进行网格优化
+         * @details 优化前后的 ACMR/ATVR 以 Debug 级别输出
+         * @param models 以对象名为键的缓冲区组装布局表
+         */
+        static void optimizeModels(std::map<std::string, VertexLayout<float>>& models);
+
+        /**
+         * @brief 带预处理网格缓存的加载
+         * @details 他似乎不需要详细注释[划掉]
+         * @param path obj文件路径
+         * @param backend 缓存失效时使用的解析后端
+         * @param optimize 是否在导入时进行网格优化
+         * @param ratios 细节层次比例[为空时不生成细节层次]
+         * @param lods 输出细节层次链表[可为空]
+         * @return 以对象名为键的缓冲区组装布局表
+         */
+        static std::map<std::string, VertexLayout<float>> cookedLoad(const std::filesystem::path& path, ObjBackend backend, bool optimize,
+            const std::vector<float>* ratios, std::map<std::string, std::vector<MeshSimplifier::Lod>>* lods);
+
         class ObjModelLoader {
             public:
                 ~ObjModelLoader() = default;
                 static std::map<std::string, VertexLayout<float>> parser(const std::string& source);
-                static void objectProcess(const std::string& name, std::istringstream &source, std::map<std::string, VertexLayout<float>>& models, VertexCounter& v, VertexCounter& t, VertexCounter& n);
-                static void lineProcess(const std::string &line, std::vector<float>& vertices, std::vector<float>& texCoord, std::vector<float>& normal, std::vector<unsigned int> &indices, VertexCounter& v, VertexCounter& t, VertexCounter& n);
+                static bool objectProcess(std::string& name, std::istringstream &source, std::map<std::string, VertexLayout<float>>& models, VertexCounter& v, VertexCounter& t, VertexCounter& n);
+                static void lineProcess(const std::string &line, ObjectBuffer& buffer, VertexCounter& v, VertexCounter& t, VertexCounter& n);
+        };
+
+        /**
+         * @brief 扫描状态
+         * @details 描述一段源在起始处的解析上下文, 用于串行与分块并行解析共享同一套逐行逻辑
+         */
+        struct ScanState {
+            bool inObject{false};
+            unsigned int mask{0};   // 所在对象的面角形式[尚无面时为 0]
+            VertexCounter v{0, 0};
+            VertexCounter t{0, 0};
+            VertexCounter n{0, 0};
+        };
+
+        /**
+         * @brief 对象片段
+         * @details 一段源内以 o 记录分隔出的对象数据; continuation 为真时表示该片段延续前一段源中的对象
+         */
+        struct ObjSegment {
+            bool continuation{false};
+            std::string name;
+            ObjectBuffer buffer;
+        };
+
+        /**
+         * @brief 分块记录计数
+         * @details 并行解析的第一遍统计结果, 用于在解析前确定每个分块的全局索引偏移
+         */
+        struct ChunkCounter {
+            bool hasObject{false};
+            size_t lead[3]{};       // 首个 o 记录之前的 v/vt/vn 数量
+            size_t tail[3]{};       // 首个 o 记录之后的 v/vt/vn 数量
+            size_t lastObject[3]{}; // 首个 o 记录到最后一个 o 记录之间的 v/vt/vn 数量
+            unsigned int leadMask{0};   // 首个 o 记录之前首个形式合法的面的面角形式
+            unsigned int tailMask{0};   // 最后一个 o 记录之后首个形式合法的面的面角形式
+        };
+
+        class ObjScanLoader {
+            public:
+                ~ObjScanLoader() = default;
+
+                /**
+                 * @brief 单遍扫描解析
+                 * @details 直接在源缓冲上以 string_view 切分行与记号, 数值通过 from_chars 转换, 解析过程中不产生逐行分配
+                 * @param source obj模型源
+                 * @param materials 材质解析上下文[可为空]
+                 * @return 以对象名为键的缓冲区组装布局表
+                 */
+                static std::map<std::string, VertexLayout<float>> parser(std::string_view source, MaterialContext* materials = nullptr);
+
+                /**
+                 * @brief 分块并行扫描解析
+                 * @details 在行边界处将源切分为若干分块, 先并行统计各分块的记录数以得到全局索引偏移,
+                 * 再并行解析各分块到独立缓冲, 最后顺序合并跨分块的对象; 源过小时退化为单线程解析
+                 * @param source obj模型源
+                 * @param threads 线程数[0 表示使用硬件并发数]
+                 * @param materials 材质解析上下文[可为空]
+                 * @return 以对象名为键的缓冲区组装布局表
+                 */
+                static std::map<std::string, VertexLayout<float>> parallelParser(std::string_view source, size_t threads = 0, MaterialContext* materials = nullptr);
+
+                /**
+                 * @brief 解析一段源
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @param chunk 源片段[以完整行为边界]
+                 * @param state 片段起始处的扫描状态
+                 * @param segments 输出的对象片段
+                 * @param libraries 输出的 mtllib 文件名
+                 */
+                static void chunkProcess(std::string_view chunk, ScanState state, std::vector<ObjSegment>& segments, std::vector<std::string>& libraries);
+
+                /**
+                 * @brief 统计一段源中的记录数
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @param chunk 源片段[以完整行为边界]
+                 * @return 记录计数
+                 */
+                static ChunkCounter chunkCount(std::string_view chunk);
+
+                /**
+                 * @brief 按顺序合并对象片段
+                 * @details 延续片段追加到前一对象, 同名对象以最后出现者为准; usemtl 状态按源顺序跨对象延续
+                 * @param segments 按源顺序排列的对象片段[数据将被移出]
+                 * @param models 输出的缓冲区组装布局表
+                 * @param materials 材质解析上下文[可为空]
+                 */
+                static void mergeSegments(std::vector<ObjSegment>& segments, std::map<std::string, VertexLayout<float>>& models, MaterialContext* materials = nullptr);
+
+                /**
+                 * @brief 分段读取输入流并逐对象回调
+                 * @details 每次处理缓冲内的完整行, 不完整的行尾移至缓冲起始处与下一段拼接
+                 * @param source 输入流
+                 * @param callback 对象回调
+                 * @param bufferSize 读取缓冲大小
+                 * @return 是否完整解析
+                 */
+                static bool streamParser(std::istream& source, const ObjectCallback& callback, size_t bufferSize);
+
+                /**
+                 * @brief 处理对象内的单行记录
+                 * @details 他似乎不需要详细注释[划掉]
+                 * @param line 行[不含换行符]
+                 * @param buffer 当前对象的解析缓冲
+                 * @param v 顶点计数
+                 * @param t 纹理坐标计数
+                 * @param n 法线计数
+                 */
+                static void lineProcess(std::string_view line, ObjectBuffer& buffer, VertexCounter& v, VertexCounter& t, VertexCounter& n);
         };
-};
\ No newline at end of file
+};
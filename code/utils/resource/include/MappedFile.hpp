@@ -0,0 +1,168 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <filesystem>
+#include <string_view>
+
+#include <GlobalLogger.hpp>
+
+/**
+ * @brief 只读文件内存映射
+ * @details 将整个文件映射进地址空间, 析构时解除映射; 空文件或映射失败时视图为空
+ */
+class MappedFile {
+    public:
+        MappedFile() = default;
+
+        /**
+         * @brief 映射文件
+         * @details 他似乎不需要详细注释[划掉]
+         * @param path 文件路径
+         * @param sequential 是否提示内核按顺序预读
+         */
+        explicit MappedFile(const std::filesystem::path& path, bool sequential = true) {
+            if (!std::filesystem::exists(path)) {
+                glog.log<DefaultLevel::Error>("文件不存在: " + path.string());
+                return;
+            }
+            #ifdef _WIN32
+                _file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                    sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (_file == INVALID_HANDLE_VALUE) {
+                    glog.log<DefaultLevel::Error>("文件无法打开: " + path.string());
+                    return;
+                }
+                LARGE_INTEGER fileSize{};
+                if (!GetFileSizeEx(_file, &fileSize) || fileSize.QuadPart == 0) {
+                    return;
+                }
+                _mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (_mapping == nullptr) {
+                    glog.log<DefaultLevel::Error>("文件映射失败: " + path.string());
+                    return;
+                }
+                _data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+                if (_data == nullptr) {
+                    glog.log<DefaultLevel::Error>("文件映射失败: " + path.string());
+                    return;
+                }
+                _size = static_cast<size_t>(fileSize.QuadPart);
+            #else
+                _file = open(path.c_str(), O_RDONLY);
+                if (_file == -1) {
+                    glog.log<DefaultLevel::Error>("文件无法打开: " + path.string());
+                    return;
+                }
+                struct stat fileStat{};
+                if (fstat(_file, &fileStat) != 0 || fileStat.st_size == 0) {
+                    return;
+                }
+                void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, _file, 0);
+                if (data == MAP_FAILED) {
+                    glog.log<DefaultLevel::Error>("文件映射失败: " + path.string());
+                    return;
+                }
+                if (sequential) {
+                    madvise(data, fileStat.st_size, MADV_SEQUENTIAL);
+                }
+                _data = static_cast<const char*>(data);
+                _size = static_cast<size_t>(fileStat.st_size);
+            #endif
+        }
+
+        ~MappedFile() {
+            release();
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator = (const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept:
+            _data(other._data),
+            _size(other._size),
+            _file(other._file)
+            #ifdef _WIN32
+            , _mapping(other._mapping)
+            #endif
+            {
+                other.forget();
+            }
+
+        MappedFile& operator = (MappedFile&& other) noexcept {
+            if (this != &other) {
+                release();
+                _data = other._data;
+                _size = other._size;
+                _file = other._file;
+                #ifdef _WIN32
+                _mapping = other._mapping;
+                #endif
+                other.forget();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief 获取映射内容视图
+         * @details 他似乎不需要详细注释[划掉]
+         * @return 内容视图
+         */
+        [[nodiscard]] std::string_view view() const {
+            return {_data, _size};
+        }
+
+        [[nodiscard]] const char* data() const {
+            return _data;
+        }
+
+        [[nodiscard]] size_t size() const {
+            return _size;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return _size == 0;
+        }
+
+        operator std::string_view () const {
+            return view();
+        }
+
+    private:
+        const char* _data{nullptr};
+        size_t _size{0};
+        #ifdef _WIN32
+            HANDLE _file{INVALID_HANDLE_VALUE};
+            HANDLE _mapping{nullptr};
+        #else
+            int _file{-1};
+        #endif
+
+        void release() {
+            #ifdef _WIN32
+                if (_data != nullptr) UnmapViewOfFile(_data);
+                if (_mapping != nullptr) CloseHandle(_mapping);
+                if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+            #else
+                if (_data != nullptr) munmap(const_cast<char*>(_data), _size);
+                if (_file != -1) close(_file);
+            #endif
+            forget();
+        }
+
+        void forget() {
+            _data = nullptr;
+            _size = 0;
+            #ifdef _WIN32
+                _file = INVALID_HANDLE_VALUE;
+                _mapping = nullptr;
+            #else
+                _file = -1;
+            #endif
+        }
+};
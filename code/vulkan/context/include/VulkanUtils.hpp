@@ -62,19 +62,19 @@ inline VkResult createBasicGraphicsDevice(PhysicalDeviceContext& physicalDeviceC
 inline VkBool32 debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageType, const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData, void *pUserData) {
     switch (messageSeverity) {
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT: {
-            glog.log<DefaultLevel::Debug>("验证层: " + std::string(pCallbackData->pMessage));
+            glog.logf<DefaultLevel::Debug>("验证层: {}", pCallbackData->pMessage);
             break;
         }
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT: {
-            glog.log<DefaultLevel::Info>("验证层: " + std::string(pCallbackData->pMessage));
+            glog.logf<DefaultLevel::Info>("验证层: {}", pCallbackData->pMessage);
             break;
         }
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT: {
-            glog.log<DefaultLevel::Warn>("验证层: " + std::string(pCallbackData->pMessage));
+            glog.logf<DefaultLevel::Warn>("验证层: {}", pCallbackData->pMessage);
             break;
         }
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT: {
-            glog.log<DefaultLevel::Error>("验证层: " + std::string(pCallbackData->pMessage));
+            glog.logf<DefaultLevel::Error>("验证层: {}", pCallbackData->pMessage);
             break;
         }
         default:;
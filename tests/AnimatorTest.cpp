@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+
+#include <Animator.h>
+
+namespace {
+    using Playback = Animator::Playback;
+    using Channel = Animator::Channel;
+
+    /**
+     * @brief 0 秒为 0, 1 秒为 10 的数值轨道
+     */
+    Animator::Track ramp(Animator& animator, float& target, const Playback mode, const float delay = 0.0f) {
+        return Animator::Builder(animator, target)
+            .key(0.0f, 0.0f)
+            .key(1.0f, 10.0f)
+            .playback(mode)
+            .delay(delay)
+            .build();
+    }
+
+    /**
+     * @brief 绕 z 轴旋转 angle 弧度
+     */
+    glm::quat aroundZ(const float angle) {
+        return {std::cos(angle * 0.5f), 0.0f, 0.0f, std::sin(angle * 0.5f)};
+    }
+}
+
+TEST(Animator, OnceStopsAtLastKey) {
+    Animator animator{};
+    float value{-1.0f};
+    const auto track = ramp(animator, value, Playback::Once);
+    EXPECT_EQ(animator.update(0.5f), 1u);
+    EXPECT_FLOAT_EQ(value, 5.0f);
+    EXPECT_EQ(animator.update(1.0f), 1u);
+    EXPECT_FLOAT_EQ(value, 10.0f);
+    EXPECT_FALSE(animator.playing(track));
+    EXPECT_EQ(animator.activeCount(), 0u);
+    value = -1.0f;
+    EXPECT_EQ(animator.update(0.5f), 0u);
+    EXPECT_FLOAT_EQ(value, -1.0f);
+}
+
+TEST(Animator, LoopWraps) {
+    Animator animator{};
+    float value{-1.0f};
+    const auto track = ramp(animator, value, Playback::Loop);
+    animator.update(0.25f);
+    EXPECT_FLOAT_EQ(value, 2.5f);
+    animator.update(1.0f);
+    EXPECT_FLOAT_EQ(value, 2.5f);
+    animator.update(3.5f);
+    EXPECT_FLOAT_EQ(value, 7.5f);
+    EXPECT_TRUE(animator.playing(track));
+}
+
+TEST(Animator, PingPongReflects) {
+    Animator animator{};
+    float value{-1.0f};
+    const auto track = ramp(animator, value, Playback::PingPong);
+    animator.update(1.25f);
+    EXPECT_FLOAT_EQ(value, 7.5f);
+    animator.update(0.5f);
+    EXPECT_FLOAT_EQ(value, 2.5f);
+    animator.update(0.5f);
+    EXPECT_FLOAT_EQ(value, 2.5f);
+    EXPECT_TRUE(animator.playing(track));
+}
+
+TEST(Animator, DelayDoesNotWriteTarget) {
+    Animator animator{};
+    float value{-1.0f};
+    ramp(animator, value, Playback::Once, 0.5f);
+    EXPECT_EQ(animator.update(0.25f), 0u);
+    EXPECT_FLOAT_EQ(value, -1.0f);
+    EXPECT_EQ(animator.update(0.5f), 1u);
+    EXPECT_FLOAT_EQ(value, 2.5f);
+}
+
+TEST(Animator, SpeedScalesClock) {
+    Animator animator{};
+    float value{-1.0f};
+    Animator::Builder(animator, value).key(0.0f, 0.0f).key(1.0f, 10.0f).speed(2.0f).build();
+    animator.update(0.25f);
+    EXPECT_FLOAT_EQ(value, 5.0f);
+}
+
+TEST(Animator, SeekRestartsAndRewinds) {
+    Animator animator{};
+    float value{-1.0f};
+    const auto track = Animator::Builder(animator, value)
+        .key(0.0f, 0.0f)
+        .key(1.0f, 10.0f)
+        .key(2.0f, 30.0f)
+        .build();
+    animator.update(1.5f);
+    EXPECT_FLOAT_EQ(value, 20.0f);
+    // 回退后须从首个区间重新定位
+    animator.seek(track, 0.5f);
+    animator.update(0.0f);
+    EXPECT_FLOAT_EQ(value, 5.0f);
+
+    animator.update(5.0f);
+    EXPECT_FALSE(animator.playing(track));
+    animator.seek(track, 1.5f);
+    animator.play(track);
+    animator.update(0.0f);
+    EXPECT_FLOAT_EQ(value, 20.0f);
+
+    // 负值为剩余延迟
+    value = -1.0f;
+    animator.seek(track, -0.5f);
+    EXPECT_EQ(animator.update(0.25f), 0u);
+    EXPECT_FLOAT_EQ(value, -1.0f);
+}
+
+TEST(Animator, StopKeepsOtherTracks) {
+    Animator animator{};
+    float values[3]{-1.0f, -1.0f, -1.0f};
+    const Animator::Track tracks[3]{
+        ramp(animator, values[0], Playback::Loop),
+        ramp(animator, values[1], Playback::Loop),
+        ramp(animator, values[2], Playback::Loop)
+    };
+    animator.stop(tracks[0]);
+    EXPECT_EQ(animator.activeCount(), 2u);
+    EXPECT_EQ(animator.update(0.5f), 2u);
+    EXPECT_FLOAT_EQ(values[0], -1.0f);
+    EXPECT_FLOAT_EQ(values[1], 5.0f);
+    EXPECT_FLOAT_EQ(values[2], 5.0f);
+    animator.play(tracks[0]);
+    animator.play(tracks[0]);
+    EXPECT_EQ(animator.activeCount(), 3u);
+    animator.clear();
+    EXPECT_EQ(animator.size(), 0u);
+    EXPECT_EQ(animator.update(0.5f), 0u);
+}
+
+TEST(Animator, WritesTransformChannels) {
+    TransformPool pool{};
+    Transform transform(pool);
+    Animator animator{};
+    Animator::Builder(animator, transform, Channel::Position).key(0.0f, glm::vec3(0.0f)).key(1.0f, glm::vec3(2.0f, 4.0f, 6.0f)).build();
+    Animator::Builder(animator, transform, Channel::Scale).key(0.0f, glm::vec3(1.0f)).key(1.0f, glm::vec3(3.0f)).build();
+    Animator::Builder(animator, transform, Channel::Origin).key(0.0f, glm::vec3(0.0f)).key(1.0f, glm::vec3(1.0f)).build();
+    animator.update(0.5f);
+    EXPECT_EQ(transform.getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(transform.getScale(), glm::vec3(2.0f));
+    EXPECT_EQ(transform.getOrigin(), glm::vec3(0.5f));
+}
+
+TEST(Animator, RotationTakesShortArc) {
+    TransformPool pool{};
+    Transform transform(pool);
+    Animator animator{};
+    // 终点与 90 度旋转互为相反数, 表示同一旋转
+    const glm::quat end = aroundZ(std::numbers::pi_v<float> / 2.0f);
+    Animator::Builder(animator, transform, Channel::Rotation)
+        .key(0.0f, aroundZ(0.0f))
+        .key(1.0f, glm::quat(-end.w, -end.x, -end.y, -end.z))
+        .build();
+    animator.update(0.5f);
+    const glm::quat expected = aroundZ(std::numbers::pi_v<float> / 4.0f);
+    const glm::quat actual = transform.getRotation();
+    EXPECT_NEAR(actual.w, expected.w, 1e-6f);
+    EXPECT_NEAR(actual.x, expected.x, 1e-6f);
+    EXPECT_NEAR(actual.y, expected.y, 1e-6f);
+    EXPECT_NEAR(actual.z, expected.z, 1e-6f);
+}
+
+TEST(Animator, EasingShapesProgress) {
+    Animator animator{};
+    const Bezier curve({0.42f, 0.0f}, {1.0f, 1.0f});
+    const auto easing = animator.addEasing(curve, 1024);
+    float value{-1.0f};
+    Animator::Builder(animator, value).key(0.0f, 0.0f, easing).key(1.0f, 10.0f).build();
+    animator.update(0.5f);
+    EXPECT_NEAR(value, 10.0 * curve.y(curve.inverse_x(0.5)), 1e-3);
+    EXPECT_LT(value, 5.0f);
+}
+
+TEST(Animator, IgnoresInvalidKeys) {
+    TransformPool pool{};
+    Transform transform(pool);
+    Animator animator{};
+    float value{-1.0f};
+    // 时间不递增与类型不符的关键帧被忽略, 未注册的缓动按线性处理
+    const auto track = Animator::Builder(animator, value)
+        .key(0.0f, 0.0f)
+        .key(0.0f, 5.0f)
+        .key(0.5f, glm::vec3(1.0f))
+        .key(1.0f, 10.0f, 7)
+        .key(2.0f, 20.0f)
+        .build();
+    ASSERT_NE(track, Animator::invalidTrack);
+    animator.update(0.5f);
+    EXPECT_FLOAT_EQ(value, 5.0f);
+
+    EXPECT_EQ(Animator::Builder(animator, value).build(), Animator::invalidTrack);
+    EXPECT_EQ(Animator::Builder(animator, transform, Channel::Value).key(0.0f, glm::vec3(1.0f)).build(), Animator::invalidTrack);
+    EXPECT_EQ(Animator::Builder(animator, transform, Channel::Position).key(0.0f, glm::quat()).build(), Animator::invalidTrack);
+    EXPECT_EQ(animator.size(), 1u);
+
+    animator.play(Animator::invalidTrack);
+    animator.stop(Animator::invalidTrack);
+    animator.seek(Animator::invalidTrack, 0.0f);
+    EXPECT_FALSE(animator.playing(Animator::invalidTrack));
+    EXPECT_EQ(animator.activeCount(), 1u);
+}
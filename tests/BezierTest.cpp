@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include <Bezier.h>
+
+namespace {
+    /**
+     * @brief 以 double 二分 60 次求得的参考缓动值
+     */
+    double reference(const Bezier& bezier, const double x) {
+        double l{0.0}, r{1.0};
+        for (size_t i = 0; i < 60; i++) {
+            const double m = (l + r) / 2;
+            (bezier.x(m) > x ? r : l) = m;
+        }
+        return bezier.y((l + r) / 2);
+    }
+
+    std::vector<float> samples() {
+        std::vector<float> out(4096);
+        for (size_t i = 0; i < out.size(); i++) {
+            out[i] = (static_cast<float>(i) + 0.5f) / static_cast<float>(out.size());
+        }
+        return out;
+    }
+}
+
+TEST(BezierInverse, ConvergesNearEndpoints) {
+    // 端点附近首个牛顿步会越出 [0, 1], 须限制在二分区间内才能收敛
+    for (const Bezier& bezier : {Bezier({0.25f, 0.1f}, {0.25f, 1.0f}), Bezier({0.9f, 0.0f}, {0.1f, 1.0f})}) {
+        const auto x = samples();
+        std::vector<float> t(x.size()), batch(x.size());
+        bezier.inverse_x(x.data(), t.data(), x.size(), 5);
+        bezier.y(t.data(), batch.data(), x.size());
+        for (size_t i = 0; i < x.size(); i++) {
+            const double expected = reference(bezier, x[i]);
+            ASSERT_NEAR(bezier.y(bezier.inverse_x(x[i], 5)), expected, 1e-6) << x[i];
+            ASSERT_NEAR(batch[i], expected, 2e-6) << x[i];
+        }
+    }
+}
+
+TEST(BezierInverse, EndpointsAreExact) {
+    const Bezier bezier({0.25f, 0.1f}, {0.25f, 1.0f});
+    EXPECT_EQ(bezier.y(bezier.inverse_x(0.0)), 0.0);
+    EXPECT_EQ(bezier.y(bezier.inverse_x(1.0)), 1.0);
+    const float x[4]{0.0f, 1.0f, -0.5f, 1.5f};
+    float t[4], y[4];
+    bezier.inverse_x(x, t, 4);
+    bezier.y(t, y, 4);
+    EXPECT_EQ(y[0], 0.0f);
+    EXPECT_EQ(y[1], 1.0f);
+    EXPECT_EQ(y[2], 0.0f);
+    EXPECT_EQ(y[3], 1.0f);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <EventBus.hpp>
+
+namespace {
+    struct Move {
+        int x;
+        int y;
+    };
+
+    constexpr EventBus::Topic moveTopic = EventBus::topic("mouse-move-callback");
+}
+
+TEST(EventBus, PublishesInSubscriptionOrder) {
+    EventBus bus{};
+    std::vector<int> order;
+    bus.subscribe<Move>("mouse-move-callback", [&](Move& e) { order.push_back(e.x); });
+    bus.subscribe<Move>("mouse-move-callback", [&](Move& e) { order.push_back(e.x * 10); });
+    bus.subscribe<int>("mouse-move-callback", [&](int&) { order.push_back(-1); });
+    Move move{1, 2};
+    bus.publish("mouse-move-callback", move);
+    bus.publish(moveTopic, move);
+    EXPECT_EQ(order, (std::vector<int>{1, 10, 1, 10}));
+}
+
+TEST(EventBus, ReentrantSubscriptionUsesStartSnapshot) {
+    EventBus bus{};
+    int first{0}, added{0};
+    size_t self{0};
+    self = bus.subscribe<int>("reentrant", [&](int&) {
+        first++;
+        // 回调内订阅与退订自身, 本次发布仍按开始时的快照进行
+        bus.subscribe<int>("reentrant", [&](int&) { added++; });
+        bus.unsubscribe<int>("reentrant", self);
+    });
+    bus.subscribe<int>("reentrant", [&](int&) { first += 10; });
+    int content{0};
+    bus.publish("reentrant", content);
+    EXPECT_EQ(first, 11);
+    EXPECT_EQ(added, 0);
+    bus.publish("reentrant", content);
+    EXPECT_EQ(first, 21);
+    EXPECT_EQ(added, 1);
+}
+
+TEST(EventBus, ReclaimsRetiredSnapshotWhenLastReaderLeaves) {
+    EventBus bus{};
+    auto token = std::make_shared<int>(0);
+    const std::weak_ptr<int> watch = token;
+    size_t self{0};
+    self = bus.subscribe<int>("reclaim", [&bus, &self, token = std::move(token)](int&) {
+        // 退订发生在发布期间, 旧快照仍持有本回调
+        bus.unsubscribe<int>("reclaim", self);
+        EXPECT_EQ(*token, 0);
+    });
+    int content{0};
+    bus.publish("reclaim", content);
+    // 无需再次订阅或退订, 发布结束时旧快照即被释放
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(EventBus, ConcurrentSubscribeDuringPublish) {
+    EventBus bus{};
+    std::atomic<long> persistent{0}, transient{0};
+    std::atomic<bool> stop{false};
+    bus.subscribe<Move>("mouse-move-callback", [&](Move& e) { persistent += e.x; });
+
+    std::vector<long> published(3, 0);
+    std::vector<std::thread> publishers;
+    for (size_t t = 0; t < published.size(); t++) {
+        publishers.emplace_back([&, t] {
+            Move move{1, 0};
+            while (!stop.load()) {
+                bus.publish(moveTopic, move);
+                published[t]++;
+            }
+        });
+    }
+    // 发布期间不断替换快照, 被替换的快照须在读者退出后才释放
+    std::thread writer([&] {
+        for (int i = 0; i < 2000; i++) {
+            const size_t id = bus.subscribe<Move>("mouse-move-callback", [&](Move&) { transient++; });
+            bus.subscribe<int>("other-" + std::to_string(i % 16), [](int&) {});
+            bus.unsubscribe<Move>("mouse-move-callback", id);
+        }
+    });
+    writer.join();
+    stop.store(true);
+    for (auto& e : publishers) e.join();
+
+    long total{0};
+    for (const long e : published) total += e;
+    EXPECT_EQ(persistent.load(), total);
+    const long before = transient.load();
+    Move move{1, 0};
+    bus.publish(moveTopic, move);
+    EXPECT_EQ(persistent.load(), total + 1);
+    EXPECT_EQ(transient.load(), before);
+}
+
+TEST(EventBus, ConcurrentPostIsDispatchedOnce) {
+    EventBus bus(256);
+    constexpr int perProducer{20000};
+    long sum{0}, received{0};
+    bus.subscribe<Move>("mouse-move-callback", [&](Move& e) {
+        sum += e.x;
+        received++;
+    });
+
+    std::atomic<long> sent{0}, sentSum{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 3; t++) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < perProducer; i++) {
+                const Move move{t * perProducer + i, 0};
+                if (bus.post(moveTopic, move)) {
+                    sent++;
+                    sentSum += move.x;
+                }
+            }
+        });
+    }
+    std::atomic<bool> done{false};
+    std::thread closer([&] {
+        for (auto& e : producers) e.join();
+        done.store(true);
+    });
+    while (!done.load()) bus.dispatch();
+    closer.join();
+    bus.dispatch();
+    EXPECT_GT(sent.load(), 0);
+    EXPECT_EQ(received, sent.load());
+    EXPECT_EQ(sum, sentSum.load());
+}
+
+TEST(EventBus, DispatchCoalescesQueuedEvents) {
+    EventBus bus{};
+    std::vector<int> latest, accumulated;
+    bus.subscribe<Move>("mouse-move-callback", [&](Move& e) { latest.push_back(e.x); });
+    bus.subscribe<int>("scroll", [&](int& e) { accumulated.push_back(e); });
+    bus.coalesce<Move>("mouse-move-callback", EventBus::Coalesce::KeepLatest);
+    bus.coalesce<int>("scroll", EventBus::Coalesce::Accumulate, [](int& merged, const int& next) { merged += next; });
+    for (int i = 1; i <= 4; i++) {
+        bus.post(moveTopic, Move{i, 0});
+        bus.post(EventBus::topic("scroll"), i);
+    }
+    EXPECT_EQ(bus.dispatch(), 8u);
+    EXPECT_EQ(latest, std::vector<int>{4});
+    EXPECT_EQ(accumulated, std::vector<int>{10});
+}
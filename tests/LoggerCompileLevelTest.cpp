@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <Logger.hpp>
+
+// 本测试目标以 LOGGER_COMPILE_LEVEL=2 编译, Debug 与 Info 在编译期移除
+static_assert(LOGGER_COMPILE_LEVEL == 2, "错误: 编译期等级测试须以 LOGGER_COMPILE_LEVEL=2 编译");
+
+namespace {
+    enum class Level {
+        Debug = 0,
+        Info,
+        Warn,
+        Error
+    };
+
+    struct Info {};
+
+    using TestLogger = Logger<Level, Info>;
+
+    /**
+     * @brief 格式化时计数的参数
+     */
+    struct Counted {
+        int& formatted;
+    };
+}
+
+template<>
+struct std::formatter<Counted> : std::formatter<int> {
+    auto format(const Counted& value, std::format_context& context) const {
+        return std::formatter<int>::format(++value.formatted, context);
+    }
+};
+
+static_assert(!TestLogger::compiled(Level::Debug));
+static_assert(!TestLogger::compiled(Level::Info));
+static_assert(TestLogger::compiled(Level::Warn));
+
+TEST(LoggerCompileLevel, RemovesLevelsBelowCompileLevel) {
+    std::vector<std::string> messages;
+    auto logger = TestLogger::builder()
+        .formatter([](const TestLogger::LogRecord& record) { return record.message; })
+        .appendHandler([&](const TestLogger::LogRecord&, const std::string& str) { messages.push_back(str); })
+        .minLevel(Level::Debug)
+        .build();
+    int formatted{0};
+
+    // 运行期最低等级放行 Debug, 编译期等级仍将其移除
+    EXPECT_FALSE(TestLogger::compiled(Level::Debug));
+    EXPECT_FALSE(logger.enabled(Level::Debug));
+    logger.logf<Level::Debug>("{}", Counted{formatted});
+    logger.log<Level::Info>(std::string("info"));
+    logger.log(Level::Debug, "debug");
+    EXPECT_EQ(formatted, 0);
+    EXPECT_TRUE(messages.empty());
+
+    logger.logf<Level::Warn>("{}", Counted{formatted});
+    EXPECT_EQ(formatted, 1);
+    EXPECT_EQ(messages, std::vector<std::string>{"1"});
+}
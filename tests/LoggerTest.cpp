@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Logger.hpp>
+
+namespace {
+    enum class Level {
+        Debug = 0,
+        Info,
+        Warn,
+        Error
+    };
+
+    struct Info {};
+
+    using TestLogger = Logger<Level, Info>;
+
+    /**
+     * @brief 格式化时计数的参数
+     */
+    struct Counted {
+        int& formatted;
+    };
+}
+
+template<>
+struct std::formatter<Counted> : std::formatter<int> {
+    auto format(const Counted& value, std::format_context& context) const {
+        return std::formatter<int>::format(++value.formatted, context);
+    }
+};
+
+namespace {
+
+    /**
+     * @brief 记录处理器收到的消息
+     * @details 处理器同一时刻只在一个线程执行; 主线程在 flush 或同步等级记录返回后读取
+     */
+    struct Sink {
+        std::vector<std::string> messages;
+        std::vector<Level> levels;
+        std::atomic<bool> entered{false};
+        std::atomic<bool> gate{true};
+
+        /**
+         * @brief 关闭闸门, 处理器在收到下一条记录时阻塞到 open
+         */
+        void close() {
+            gate.store(false);
+        }
+
+        void open() {
+            gate.store(true);
+            gate.notify_all();
+        }
+
+        void waitEntered() const {
+            while (!entered.load()) std::this_thread::yield();
+        }
+
+        /**
+         * @brief 给构建者配置格式化器与记录处理器
+         * @details 构建者不可移动, 在同一表达式中接着配置并构建
+         */
+        TestLogger::LoggerBuilder& attach(TestLogger::LoggerBuilder&& builder) {
+            return builder.formatter([](const TestLogger::LogRecord& record) { return record.message; })
+                .appendHandler([this](const TestLogger::LogRecord& record, const std::string& str) {
+                    messages.push_back(str);
+                    levels.push_back(record.level);
+                    entered.store(true);
+                    gate.wait(false);
+                });
+        }
+    };
+
+    /**
+     * @brief 阻塞后台线程并填满容量为 2 的队列
+     * @details 首条记录被后台线程取走后阻塞在处理器中, 随后两条占满队列
+     */
+    void fill(TestLogger& logger, Sink& sink) {
+        sink.close();
+        logger.log(Level::Info, "first");
+        sink.waitEntered();
+        logger.log(Level::Info, "queued 0");
+        logger.log(Level::Info, "queued 1");
+    }
+}
+
+TEST(Logger, KeepsPerProducerOrder) {
+    Sink sink{};
+    auto logger = sink.attach(TestLogger::builder()).async(64).build();
+    constexpr size_t producers{4}, perProducer{2000};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < producers; t++) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < perProducer; i++) {
+                logger.log(Level::Info, std::to_string(t) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& e : threads) e.join();
+    logger.flush();
+
+    ASSERT_EQ(sink.messages.size(), producers * perProducer);
+    std::vector<size_t> next(producers, 0);
+    for (const auto& message : sink.messages) {
+        const size_t split = message.find(':');
+        const size_t t = std::stoul(message.substr(0, split));
+        ASSERT_EQ(std::stoul(message.substr(split + 1)), next[t]) << t;
+        next[t]++;
+    }
+}
+
+TEST(Logger, DropDiscardsWithoutCounting) {
+    Sink sink{};
+    auto logger = sink.attach(TestLogger::builder()).async(2, TestLogger::Overflow::Drop).reportDropped(Level::Warn).build();
+    fill(logger, sink);
+    logger.log(Level::Info, "dropped");
+    sink.open();
+    logger.flush();
+    EXPECT_EQ(logger.dropped(), 0u);
+    EXPECT_EQ(sink.messages, (std::vector<std::string>{"first", "queued 0", "queued 1"}));
+}
+
+TEST(Logger, DropAndCountReportsOnFlush) {
+    Sink sink{};
+    auto logger = sink.attach(TestLogger::builder()).async(2, TestLogger::Overflow::DropAndCount).reportDropped(Level::Warn).build();
+    fill(logger, sink);
+    for (int i = 0; i < 5; i++) {
+        logger.log(Level::Info, "dropped");
+    }
+    EXPECT_EQ(logger.dropped(), 5u);
+    sink.open();
+    logger.flush();
+    ASSERT_EQ(sink.messages.size(), 4u);
+    EXPECT_EQ(sink.messages.back(), "日志队列已满, 已丢弃 5 条记录");
+    EXPECT_EQ(sink.levels.back(), Level::Warn);
+
+    // 已报告的丢弃不再重复报告
+    logger.flush();
+    EXPECT_EQ(sink.messages.size(), 4u);
+    EXPECT_EQ(logger.dropped(), 5u);
+}
+
+TEST(Logger, DropAndCountReportsOnDestruction) {
+    Sink sink{};
+    {
+        auto logger = sink.attach(TestLogger::builder()).async(2, TestLogger::Overflow::DropAndCount).reportDropped(Level::Warn).build();
+        fill(logger, sink);
+        logger.log(Level::Info, "dropped");
+        sink.open();
+    }
+    ASSERT_EQ(sink.messages.size(), 4u);
+    EXPECT_EQ(sink.messages.back(), "日志队列已满, 已丢弃 1 条记录");
+}
+
+TEST(Logger, BlockWaitsForSpace) {
+    Sink sink{};
+    auto logger = sink.attach(TestLogger::builder()).async(2, TestLogger::Overflow::Block).build();
+    fill(logger, sink);
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (int i = 0; i < 3; i++) {
+            logger.log(Level::Info, "blocked " + std::to_string(i));
+        }
+        done.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    // 后台线程阻塞在处理器中, 队列无法腾出位置
+    EXPECT_FALSE(done.load());
+    sink.open();
+    producer.join();
+    logger.flush();
+    EXPECT_EQ(logger.dropped(), 0u);
+    EXPECT_EQ(sink.messages, (std::vector<std::string>{"first", "queued 0", "queued 1", "blocked 0", "blocked 1", "blocked 2"}));
+}
+
+TEST(Logger, SyncLevelIsWrittenBeforeReturn) {
+    Sink sink{};
+    auto logger = sink.attach(TestLogger::builder()).async(64).syncLevel(Level::Error).build();
+    for (int i = 0; i < 10; i++) {
+        logger.log(Level::Info, "info " + std::to_string(i));
+    }
+    logger.log(Level::Error, "error");
+    // 同步等级的记录连同其之前的记录都已写出
+    ASSERT_EQ(sink.messages.size(), 11u);
+    EXPECT_EQ(sink.messages.front(), "info 0");
+    EXPECT_EQ(sink.messages.back(), "error");
+}
+
+TEST(Logger, FlushDrainsQueue) {
+    Sink sink{};
+    auto logger = sink.attach(TestLogger::builder()).async(16).build();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 500; i++) {
+                logger.log(Level::Warn, "message");
+            }
+        });
+    }
+    for (auto& e : threads) e.join();
+    logger.flush();
+    EXPECT_EQ(sink.messages.size(), 1000u);
+    EXPECT_EQ(logger.dropped(), 0u);
+}
+
+TEST(Logger, SkipsFormattingBelowMinLevel) {
+    Sink sink{};
+    auto logger = sink.attach(TestLogger::builder()).minLevel(Level::Warn).build();
+    int formatted{0};
+    logger.logf<Level::Info>("{}", Counted{formatted});
+    logger.logf<Level::Error>("{}", Counted{formatted});
+    // 低于最低等级的记录不格式化参数
+    EXPECT_EQ(formatted, 1);
+    EXPECT_EQ(sink.messages, std::vector<std::string>{"1"});
+
+    logger.setMinLevel(Level::Info);
+    logger.logf<Level::Info>("{}", Counted{formatted});
+    EXPECT_EQ(formatted, 2);
+    EXPECT_EQ(sink.messages.back(), "2");
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+#include <MeshOptimizer.h>
+#include <VertexLayout.hpp>
+
+namespace {
+    /**
+     * @brief n x n 个格子的网格
+     * @details 面角只引用位置, 三角形按行交错写出使初始顺序对缓存不友好
+     */
+    VertexLayout<float> grid(const unsigned int n) {
+        std::vector<float> positions{};
+        for (unsigned int y = 0; y <= n; y++) {
+            for (unsigned int x = 0; x <= n; x++) {
+                positions.insert(positions.end(), {static_cast<float>(x), 0.0f, static_cast<float>(y)});
+            }
+        }
+        std::vector<unsigned int> indices{};
+        for (unsigned int x = 0; x < n; x++) {
+            for (unsigned int y = 0; y < n; y++) {
+                const unsigned int a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+                indices.insert(indices.end(), {a, c, b, b, c, d});
+            }
+        }
+        return VertexLayout<float>::builder()
+            .appendElement("vertices", 3)
+            .attachSource("vertices", std::move(positions))
+            .attachIndices(std::move(indices))
+            .build();
+    }
+
+    /**
+     * @brief 经纬球面
+     * @details 三角形按经线逐列写出, 外法线朝外
+     */
+    void sphere(const unsigned int rings, const unsigned int segments, std::vector<float>& positions, std::vector<unsigned int>& indices) {
+        for (unsigned int r = 0; r <= rings; r++) {
+            const float theta = std::numbers::pi_v<float> * static_cast<float>(r) / static_cast<float>(rings);
+            for (unsigned int s = 0; s <= segments; s++) {
+                const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s) / static_cast<float>(segments);
+                positions.insert(positions.end(), {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            }
+        }
+        for (unsigned int s = 0; s < segments; s++) {
+            for (unsigned int r = 0; r < rings; r++) {
+                const unsigned int a = r * (segments + 1) + s, b = a + 1, c = a + segments + 1, d = c + 1;
+                indices.insert(indices.end(), {a, b, c, b, d, c});
+            }
+        }
+    }
+
+    /**
+     * @brief 以位置描述的三角形集合[与顶点编号及三角形顺序无关]
+     */
+    std::vector<std::array<float, 9>> triangles(const VertexLayout<float>& layout) {
+        const std::vector<float>& welded = layout.WeldIndices();
+        const auto& indices = layout.bufferOfIndices();
+        std::vector<std::array<float, 9>> out(indices.size() / 3);
+        for (size_t t = 0; t < out.size(); t++) {
+            for (size_t k = 0; k < 3; k++) {
+                std::copy_n(welded.begin() + indices[t * 3 + k] * 3, 3, out[t].begin() + k * 3);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+}
+
+TEST(MeshOptimizer, KeepsTriangles) {
+    auto layout = grid(32);
+    const auto before = triangles(layout);
+    MeshOptimizer::optimize(layout);
+    EXPECT_EQ(before, triangles(layout));
+}
+
+TEST(MeshOptimizer, ImprovesVertexCache) {
+    auto layout = grid(32);
+    const auto report = MeshOptimizer::optimize(layout);
+    EXPECT_LT(report.after.acmr, report.before.acmr);
+    EXPECT_LE(report.after.atvr, report.before.atvr);
+}
+
+TEST(MeshOptimizer, NumbersVerticesInFirstUseOrder) {
+    auto layout = grid(32);
+    MeshOptimizer::optimize(layout);
+    unsigned int next{0};
+    for (const unsigned int e : layout.bufferOfIndices()) {
+        ASSERT_LE(e, next);
+        if (e == next) next++;
+    }
+    EXPECT_EQ(next, layout.WeldIndices().size() / 3);
+}
+
+TEST(MeshOptimizer, OverdrawDrawsOutwardClustersFirst) {
+    // 两个朝 +z 的平行四边形, 位于 z = 0 的先写出; 网格中心在 z = 0.5, 朝外的 z = 1 应先绘制
+    const std::vector<float> positions{
+        0, 0, 0,  1, 0, 0,  0, 1, 0,  1, 1, 0,
+        0, 0, 1,  1, 0, 1,  0, 1, 1,  1, 1, 1
+    };
+    const std::vector<unsigned int> indices{0, 1, 2, 1, 3, 2, 4, 5, 6, 5, 7, 6};
+    const auto order = MeshOptimizer::overdrawOrder(indices, positions.data(), 8, 3);
+    EXPECT_EQ(order, (std::vector<unsigned int>{2, 3, 0, 1}));
+    EXPECT_EQ(MeshOptimizer::optimizeOverdraw(indices, positions.data(), 8, 3),
+        (std::vector<unsigned int>{4, 5, 6, 5, 7, 6, 0, 1, 2, 1, 3, 2}));
+}
+
+TEST(MeshOptimizer, OverdrawKeepsCacheWithinThreshold) {
+    std::vector<float> positions{};
+    std::vector<unsigned int> indices{};
+    sphere(32, 64, positions, indices);
+    const size_t vertexCount = positions.size() / 3;
+    const auto cached = MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+    const float acmr = MeshOptimizer::analyzeVertexCache(cached, vertexCount).acmr;
+    for (const float threshold : {1.0f, 1.05f, 1.5f}) {
+        const auto order = MeshOptimizer::overdrawOrder(cached, positions.data(), vertexCount, 3, threshold);
+        ASSERT_EQ(order.size(), cached.size() / 3);
+        EXPECT_FALSE(std::is_sorted(order.begin(), order.end())) << threshold;
+        std::vector<unsigned int> sorted(order);
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < sorted.size(); i++) {
+            ASSERT_EQ(sorted[i], i);
+        }
+        const auto reordered = MeshOptimizer::optimizeOverdraw(cached, positions.data(), vertexCount, 3, threshold);
+        // 末尾不足以切分的簇可能略超阈值
+        EXPECT_LE(MeshOptimizer::analyzeVertexCache(reordered, vertexCount).acmr, acmr * threshold * 1.02f) << threshold;
+    }
+}
+
+TEST(MeshOptimizer, OptimizeCanSkipOverdraw) {
+    auto a = grid(16), b = grid(16);
+    const auto withOverdraw = MeshOptimizer::optimize(a);
+    const auto cacheOnly = MeshOptimizer::optimize(b, MeshOptimizer::defaultCacheSize, 0.0f);
+    EXPECT_EQ(triangles(a), triangles(b));
+    EXPECT_LE(withOverdraw.after.acmr, cacheOnly.after.acmr * MeshOptimizer::defaultOverdrawThreshold * 1.02f);
+}
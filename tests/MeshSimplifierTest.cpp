@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+
+#include <MeshSimplifier.h>
+
+namespace {
+    /**
+     * @brief 半径为 radius 的经纬球面, 每个顶点带一个纹理坐标
+     * @details 顶点步长 5, 位置偏移 0
+     */
+    void sphere(const float radius, std::vector<float>& vertices, std::vector<unsigned int>& indices) {
+        constexpr unsigned int rings{24}, segments{48};
+        for (unsigned int r = 0; r <= rings; r++) {
+            const float theta = std::numbers::pi_v<float> * static_cast<float>(r) / static_cast<float>(rings);
+            for (unsigned int s = 0; s <= segments; s++) {
+                const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s) / static_cast<float>(segments);
+                vertices.insert(vertices.end(), {
+                    radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta), radius * std::sin(theta) * std::sin(phi),
+                    static_cast<float>(s) / static_cast<float>(segments), static_cast<float>(r) / static_cast<float>(rings)
+                });
+            }
+        }
+        for (unsigned int r = 0; r < rings; r++) {
+            for (unsigned int s = 0; s < segments; s++) {
+                const unsigned int a = r * (segments + 1) + s, b = a + 1, c = a + segments + 1, d = c + 1;
+                indices.insert(indices.end(), {a, b, c, b, d, c});
+            }
+        }
+    }
+
+    float simplifiedError(const float radius, const MeshSimplifier::Options& options) {
+        std::vector<float> vertices{};
+        std::vector<unsigned int> indices{};
+        sphere(radius, vertices, indices);
+        float error{-1.0f};
+        MeshSimplifier::simplify(indices, vertices.data(), vertices.size() / 5, 5, 0, indices.size() / 4, options, &error);
+        return error;
+    }
+}
+
+TEST(MeshSimplifier, ErrorIsInDistanceUnits) {
+    // 不计属性时折叠顺序与尺度无关, 误差应随半径线性缩放[面积加权的二次误差会按平方缩放]
+    MeshSimplifier::Options positionOnly{};
+    positionOnly.attributeWeight = 0.0f;
+    const float unit = simplifiedError(1.0f, positionOnly);
+    EXPECT_GT(unit, 0.0f);
+    EXPECT_LT(unit, 0.2f);
+    EXPECT_NEAR(simplifiedError(10.0f, positionOnly), unit * 10.0f, unit * 10.0f * 0.05f);
+}
+
+TEST(MeshSimplifier, ErrorExcludesAttributeWeight) {
+    MeshSimplifier::Options heavy{};
+    heavy.attributeWeight = 1000.0f;
+    // 属性权重只改变折叠顺序, 报告的位置误差不超过球面半径的量级
+    const float error = simplifiedError(1.0f, heavy);
+    EXPECT_GE(error, 0.0f);
+    EXPECT_LT(error, 0.2f);
+}
+
+TEST(MeshSimplifier, MaxErrorLimitsPositionError) {
+    MeshSimplifier::Options limited{};
+    limited.maxError = simplifiedError(1.0f, {}) * 0.5f;
+    EXPECT_LE(simplifiedError(1.0f, limited), limited.maxError);
+}
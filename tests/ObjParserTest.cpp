@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <ModelParser.h>
+
+namespace {
+    using Backend = ModelParser::ObjBackend;
+    using Models = std::map<std::string, VertexLayout<float>>;
+
+    /**
+     * @brief 布局的元素与原始面角索引是否完全一致
+     */
+    void expectSameModels(const Models& expected, const Models& actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (const auto& [name, layout] : expected) {
+            const auto it = actual.find(name);
+            ASSERT_NE(it, actual.end()) << name;
+            const auto& a = layout.elements();
+            const auto& b = it->second.elements();
+            ASSERT_EQ(a.size(), b.size()) << name;
+            for (size_t i = 0; i < a.size(); i++) {
+                EXPECT_EQ(a[i].identifier, b[i].identifier) << name;
+                EXPECT_EQ(a[i].getSource(), b[i].getSource()) << name << ": " << a[i].identifier;
+            }
+            EXPECT_EQ(layout.rawIndices(), it->second.rawIndices()) << name;
+        }
+    }
+
+    Models streamLoad(const std::string& source, size_t bufferSize) {
+        Models out{};
+        std::istringstream stream(source);
+        ModelParser::ObjStreamLoader(stream, [&](std::string name, VertexLayout<float> layout) {
+            out.insert_or_assign(std::move(name), std::move(layout));
+            return true;
+        }, bufferSize);
+        return out;
+    }
+
+    /**
+     * @brief 凹四边形[飞镖形]
+     * @details 第 4 个角为凹点, 从第 1 个角扇形展开会得到落在多边形外的三角形, 正确的对角线为 2-4
+     */
+    void appendDart(std::string& source, const float x, const float y) {
+        char line[96];
+        for (const auto& [u, w] : {std::pair{0.0f, 4.0f}, {0.0f, 0.0f}, {4.0f, 0.0f}, {1.0f, 1.0f}}) {
+            source.append(line, std::snprintf(line, sizeof(line), "v %.3f %.3f 0.0\n", x + u, y + w));
+        }
+    }
+
+    /**
+     * @brief 超过 4MB 的多对象源
+     * @details dart 对象先写出全部顶点再写出全部面, 分块后靠后分块的面引用前一分块的顶点, 且夹杂着形式不一致的面;
+     * mixed 对象交错写出顶点与面, 含负索引, 引用后续顶点的面, v/vt/vn 形式与形式不一致的面
+     */
+    std::string largeSource() {
+        constexpr size_t dartCount{24000};
+        std::string source{"o dart\n"};
+        for (size_t i = 0; i < dartCount; i++) {
+            appendDart(source, static_cast<float>(i % 200) * 5.0f, static_cast<float>(i / 200) * 5.0f);
+        }
+        for (size_t i = 0; i < dartCount; i++) {
+            const size_t a = i * 4 + 1;
+            // 首个面之后每个面前都有一个形式不一致的面, 分块起始处的首个面多为后者
+            if (i != 0) {
+                source += "f " + std::to_string(a) + "/1 " + std::to_string(a + 1) + "/1 " + std::to_string(a + 2) + "/1\n";
+            }
+            source += "f " + std::to_string(a) + ' ' + std::to_string(a + 1) + ' ' + std::to_string(a + 2) + ' ' + std::to_string(a + 3) + '\n';
+        }
+        source += "o mixed\nvn 0 0 1\n";
+        for (size_t i = 0; i < dartCount; i++) {
+            // 先引用随后定义的 4 个顶点, 再以负索引引用同一组顶点
+            const size_t a = dartCount * 4 + i * 4 + 1;
+            source += "f " + std::to_string(a) + "/1/1 " + std::to_string(a + 1) + "/1/1 " + std::to_string(a + 2) + "/1/1 " + std::to_string(a + 3) + "/1/1\n";
+            appendDart(source, static_cast<float>(i % 200) * 5.0f, static_cast<float>(i / 200) * 5.0f);
+            source += "vt 0.5 0.5\n";
+            source += "f -3 -2 -1\n";
+            source += "f -4/-1/-1 -3/-1/-1 -2/-1/-1 -1/-1/-1\n";
+        }
+        return source;
+    }
+
+    /**
+     * @brief 写入临时目录的 obj 与 mtl
+     * @details 析构时删除目录
+     */
+    class MaterialFixture {
+        public:
+            MaterialFixture(const std::string& name, const std::string& obj, const std::string& mtl):
+                _directory(std::filesystem::temp_directory_path() / ("obj_parser_test_" + name)) {
+                std::filesystem::create_directories(_directory);
+                std::ofstream(_directory / "model.obj", std::ios::binary) << obj;
+                std::ofstream(_directory / "model.mtl", std::ios::binary) << mtl;
+            }
+
+            ~MaterialFixture() {
+                std::error_code ec;
+                std::filesystem::remove_all(_directory, ec);
+            }
+
+            [[nodiscard]] const std::filesystem::path& directory() const {
+                return _directory;
+            }
+
+            Models load(MaterialLibrary& materials, std::map<std::string, std::vector<Submesh>>& submeshes, const Backend backend) const {
+                return ModelParser::ObjModelLoader(_directory / "model.obj", materials, submeshes, backend);
+            }
+
+        private:
+            std::filesystem::path _directory;
+    };
+
+    void expectSubmesh(const Submesh& submesh, const uint32_t material, const uint32_t offset, const uint32_t count) {
+        EXPECT_EQ(submesh.material, material);
+        EXPECT_EQ(submesh.indexOffset, offset);
+        EXPECT_EQ(submesh.indexCount, count);
+    }
+
+    constexpr const char* triangleVertices{
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nv 2 1 0\nv 2 2 0\n"
+        "vt 0 0\nvt 1 0\nvt 0 1\n"
+    };
+}
+
+TEST(ObjParser, EarClipsConcavePolygon) {
+    std::string source{"o dart\n"};
+    appendDart(source, 0.0f, 0.0f);
+    source += "f 1 2 3 4\n";
+    for (const auto backend : {Backend::Stream, Backend::Scan, Backend::ParallelScan}) {
+        const auto models = ModelParser::ObjModelLoader(source, backend);
+        const auto& indices = models.at("dart").rawIndices();
+        ASSERT_EQ(indices.size(), 6u);
+        // 两个三角形都应包含对角线 2-4
+        for (size_t t = 0; t < 2; t++) {
+            const auto begin = indices.begin() + static_cast<ptrdiff_t>(t * 3);
+            EXPECT_NE(std::find(begin, begin + 3, 1u), begin + 3);
+            EXPECT_NE(std::find(begin, begin + 3, 3u), begin + 3);
+        }
+    }
+}
+
+TEST(ObjParser, ParallelScanMatchesScanAcrossChunks) {
+    const std::string source = largeSource();
+    ASSERT_GT(source.size(), size_t{4} << 20);
+    const auto scan = ModelParser::ObjModelLoader(source, Backend::Scan);
+    ASSERT_EQ(scan.at("dart").rawIndices().size(), size_t{24000} * 6);
+    ASSERT_EQ(scan.at("mixed").rawIndices().size(), size_t{24000} * 2 * 6 * 3);
+
+    ModelParser::parallelThreads(8);
+    const auto parallel = ModelParser::ObjModelLoader(source, Backend::ParallelScan);
+    ModelParser::parallelThreads(0);
+    expectSameModels(scan, parallel);
+    expectSameModels(scan, ModelParser::ObjModelLoader(source, Backend::Stream));
+    expectSameModels(scan, streamLoad(source, 4096));
+}
+
+TEST(ObjParser, DropsFacesWithMismatchedForms) {
+    const std::string source{
+        "o a\n"
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "vt 0 0\nvt 1 0\nvt 0 1\n"
+        "vn 0 0 1\n"
+        "f 1/1 2/2 3/3\n"
+        "f 1 2 3\n"
+        "f 1/1/1 2/2/1 3/3/1\n"
+        "f 3/3 2/2 1/1\n"
+    };
+    for (const auto backend : {Backend::Stream, Backend::Scan, Backend::ParallelScan}) {
+        const auto models = ModelParser::ObjModelLoader(source, backend);
+        const auto& layout = models.at("a");
+        // 首个面为 v/vt, 未被引用的法线不进入布局
+        ASSERT_EQ(layout.elements().size(), 2u);
+        EXPECT_EQ(layout.elements()[1].identifier, "texCoord");
+        EXPECT_EQ(layout.rawIndices(), (std::vector<unsigned int>{0, 0, 1, 1, 2, 2, 2, 2, 1, 1, 0, 0}));
+    }
+}
+
+TEST(ObjParser, DropsOutOfRangeFaces) {
+    const std::string source{
+        "o a\n"
+        "f 1 2 3\n"
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "f 1 2 99999\n"
+        "f 1 2 4294967299\n"
+        "f 3 2 1\n"
+        "o b\n"
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "f 4 5 7\n"
+        "f 4 5 6\n"
+    };
+    for (const auto backend : {Backend::Stream, Backend::Scan, Backend::ParallelScan}) {
+        const auto models = ModelParser::ObjModelLoader(source, backend);
+        // 引用随后定义的顶点的面保留
+        EXPECT_EQ(models.at("a").rawIndices(), (std::vector<unsigned int>{0, 1, 2, 2, 1, 0}));
+        EXPECT_EQ(models.at("b").rawIndices(), (std::vector<unsigned int>{0, 1, 2}));
+    }
+    const auto streamed = streamLoad(source, 16);
+    EXPECT_EQ(streamed.at("a").rawIndices(), (std::vector<unsigned int>{0, 1, 2, 2, 1, 0}));
+}
+
+TEST(ObjMaterial, GroupsInterleavedRuns) {
+    // A B B A 四个 v/vt 面, 每个面角占 2 个原始索引, 子网格以面角计
+    const MaterialFixture fixture("interleaved", std::string("mtllib model.mtl\no a\n") + triangleVertices +
+        "usemtl A\nf 1/1 2/2 3/3\n"
+        "usemtl B\nf 2/1 4/2 3/3\nf 4/1 5/2 3/3\n"
+        "usemtl A\nf 5/1 6/2 4/3\n",
+        "newmtl A\nnewmtl B\n");
+    for (const auto backend : {Backend::Scan, Backend::ParallelScan}) {
+        MaterialLibrary materials{};
+        std::map<std::string, std::vector<Submesh>> submeshes{};
+        const auto models = fixture.load(materials, submeshes, backend);
+        const auto& groups = submeshes.at("a");
+        ASSERT_EQ(groups.size(), 2u);
+        expectSubmesh(groups[0], materials.find("A"), 0, 6);
+        expectSubmesh(groups[1], materials.find("B"), 6, 6);
+        EXPECT_EQ(models.at("a").rawIndices(), (std::vector<unsigned int>{
+            0, 0, 1, 1, 2, 2,  4, 0, 5, 1, 3, 2,
+            1, 0, 3, 1, 2, 2,  3, 0, 4, 1, 2, 2
+        }));
+    }
+}
+
+TEST(ObjMaterial, KeepsRunsAroundDeferredFaces) {
+    // 首个面引用随后定义的顶点, 延后三角化时须平移其后的材质区间起点
+    const MaterialFixture fixture("deferred",
+        "mtllib model.mtl\no a\n"
+        "usemtl A\nf 1 2 3\n"
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "usemtl B\nf 1 2 3\n"
+        "usemtl A\nf 3 2 1\n",
+        "newmtl A\nnewmtl B\n");
+    for (const auto backend : {Backend::Scan, Backend::ParallelScan}) {
+        MaterialLibrary materials{};
+        std::map<std::string, std::vector<Submesh>> submeshes{};
+        const auto models = fixture.load(materials, submeshes, backend);
+        const auto& groups = submeshes.at("a");
+        ASSERT_EQ(groups.size(), 2u);
+        expectSubmesh(groups[0], materials.find("A"), 0, 6);
+        expectSubmesh(groups[1], materials.find("B"), 6, 3);
+        EXPECT_EQ(models.at("a").rawIndices(), (std::vector<unsigned int>{0, 1, 2, 2, 1, 0, 0, 1, 2}));
+    }
+}
+
+TEST(ObjMaterial, InheritsMaterialIntoNextObject) {
+    // 每个对象拥有自己的顶点, 面按全局编号引用; usemtl 的状态跨越 o 延续
+    const MaterialFixture fixture("inherit", std::string("mtllib model.mtl\n")
+        + "o a\nv 0 0 0\nv 1 0 0\nv 0 1 0\nusemtl A\nf 1 2 3\n"
+        + "o b\n" + triangleVertices + "f 4 5 6\nusemtl B\nf 5 7 6\n"
+        + "o c\nv 0 0 0\nv 1 0 0\nv 0 1 0\nf 10 11 12\n",
+        "newmtl A\nnewmtl B\n");
+    for (const auto backend : {Backend::Scan, Backend::ParallelScan}) {
+        MaterialLibrary materials{};
+        std::map<std::string, std::vector<Submesh>> submeshes{};
+        fixture.load(materials, submeshes, backend);
+        ASSERT_EQ(submeshes.at("b").size(), 2u);
+        expectSubmesh(submeshes.at("b")[0], materials.find("A"), 0, 3);
+        expectSubmesh(submeshes.at("b")[1], materials.find("B"), 3, 3);
+        ASSERT_EQ(submeshes.at("c").size(), 1u);
+        expectSubmesh(submeshes.at("c")[0], materials.find("B"), 0, 3);
+    }
+}
+
+TEST(ObjMaterial, ParsesLibraryThroughFallback) {
+    // mtllib 指向不存在的文件时回退到同名 mtl
+    const MaterialFixture fixture("fallback", std::string("mtllib missing.mtl\no a\n") + triangleVertices + "usemtl grey\nf 1 2 3\n",
+        "# comment\n"
+        "newmtl grey\n"
+        "Kd 0.5\n"
+        "Ks 0.1 0.2 0.3\n"
+        "Tr 0.25\n"
+        "map_Kd -bm 1 tex.png\n"
+        "map_Bump textures/normal.png\n");
+    MaterialLibrary materials{};
+    std::map<std::string, std::vector<Submesh>> submeshes{};
+    fixture.load(materials, submeshes, Backend::Scan);
+    const uint32_t id = materials.find("grey");
+    ASSERT_NE(id, MaterialLibrary::invalidId);
+    const Material& grey = materials[id];
+    EXPECT_EQ(grey.diffuse[0], 0.5f);
+    EXPECT_EQ(grey.diffuse[1], 0.5f);
+    EXPECT_EQ(grey.diffuse[2], 0.5f);
+    EXPECT_EQ(grey.specular[2], 0.3f);
+    EXPECT_EQ(grey.dissolve, 0.75f);
+    EXPECT_EQ(grey.diffuseMap, (fixture.directory() / "tex.png").lexically_normal().generic_string());
+    EXPECT_EQ(grey.normalMap, (fixture.directory() / "textures/normal.png").lexically_normal().generic_string());
+    expectSubmesh(submeshes.at("a").at(0), id, 0, 3);
+}
+
+TEST(ObjMaterial, KeepsAbsoluteTexturePaths) {
+    MaterialLibrary materials{};
+    EXPECT_EQ(materials.parse("newmtl a\nmap_Kd -o 0 0 0 /textures/a.png\nnewmtl b\nmap_Kd D:/textures/b.png\n", "base"), 2u);
+    EXPECT_EQ(materials[materials.find("a")].diffuseMap, "/textures/a.png");
+    EXPECT_EQ(materials[materials.find("b")].diffuseMap, "D:/textures/b.png");
+    // 未在 mtl 中定义的材质以默认值占位
+    const Material& placeholder = materials[materials.intern("missing")];
+    EXPECT_EQ(placeholder.name, "missing");
+    EXPECT_EQ(placeholder.diffuse[0], 0.8f);
+}
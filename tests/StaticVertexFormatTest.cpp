@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <cstring>
+
+#include <StaticVertexFormat.hpp>
+
+namespace {
+    using ColorFormat = vertex_format::Format<float,
+        vertex_format::Attribute<"position", 4>,
+        vertex_format::Attribute<"weight", 1>>;
+
+    std::vector<float> sequence(size_t count, float scale) {
+        std::vector<float> out(count);
+        for (size_t i = 0; i < count; i++) {
+            out[i] = static_cast<float>(i) * scale;
+        }
+        return out;
+    }
+
+    bool bitwiseEqual(const std::vector<float>& a, const std::vector<float>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+}
+
+TEST(StaticVertexFormat, LayoutIsComputedAtCompileTime) {
+    static_assert(vertex_format::PositionTexCoordNormal::stride == 8);
+    static_assert(vertex_format::PositionTexCoordNormal::offsets[2] == 5);
+    static_assert(ColorFormat::stride == 5);
+    static_assert(ColorFormat::offsets[1] == 4);
+    SUCCEED();
+}
+
+TEST(StaticVertexFormat, PositionTexCoordNormalMatchesRuntimeKernel) {
+    // 源列恰好容纳所有顶点, 最后一个顶点不能多读
+    constexpr unsigned int vertexCount{37};
+    const auto positions = sequence(vertexCount * 3, 0.5f);
+    const auto texCoords = sequence(vertexCount * 2, 0.25f);
+    const auto normals = sequence(vertexCount * 3, -0.125f);
+    const std::vector<interleave::Column<float>> columns{
+        {positions.data(), 3, positions.size()}, {texCoords.data(), 2, texCoords.size()}, {normals.data(), 3, normals.size()}};
+
+    std::vector<float> expected(vertexCount * 8), actual(vertexCount * 8);
+    interleave::sequential(columns, vertexCount, 8, expected.data());
+    vertex_format::PositionTexCoordNormal::sequential(columns, vertexCount, 8, actual.data());
+    EXPECT_TRUE(bitwiseEqual(actual, expected));
+
+    std::vector<unsigned int> indices{};
+    for (unsigned int c = 0; c < 100; c++) {
+        const unsigned int v = c * 7 % vertexCount;
+        indices.insert(indices.end(), {v, (v + 3) % vertexCount, vertexCount - 1 - v});
+    }
+    expected.assign(100 * 8, 0.0f);
+    actual.assign(100 * 8, 0.0f);
+    interleave::gather(columns, indices.data(), 100, 8, expected.data());
+    vertex_format::PositionTexCoordNormal::gather(columns, indices.data(), 100, 8, actual.data());
+    EXPECT_TRUE(bitwiseEqual(actual, expected));
+}
+
+TEST(StaticVertexFormat, UnrolledFormatMatchesRuntimeKernel) {
+    constexpr size_t vertexCount{16};
+    const auto positions = sequence(vertexCount * 4, 1.5f);
+    const auto weights = sequence(vertexCount, 0.75f);
+    const std::vector<interleave::Column<float>> columns{{positions.data(), 4, positions.size()}, {weights.data(), 1, weights.size()}};
+
+    std::vector<float> expected(vertexCount * 5), actual(vertexCount * 5);
+    interleave::sequential(columns, vertexCount, 5, expected.data());
+    ColorFormat::sequential(columns, vertexCount, 5, actual.data());
+    EXPECT_TRUE(bitwiseEqual(actual, expected));
+}
+
+TEST(StaticVertexFormat, BoundLayoutAssemblesLikeRuntimeLayout) {
+    auto build = [](bool bind) {
+        auto builder = bind ? vertex_format::PositionTexCoordNormal::builder() : VertexLayout<float>::builder()
+            .appendElement("vertices", 3)
+            .appendElement("texCoord", 2)
+            .appendElement("normal", 3);
+        return builder
+            .attachSource("vertices", sequence(12, 1.0f))
+            .attachSource("texCoord", sequence(8, 0.5f))
+            .attachSource("normal", sequence(12, -1.0f))
+            .attachIndices(std::vector<unsigned int>{0, 0, 0, 1, 2, 3, 3, 3, 1, 2, 1, 0})
+            .build();
+    };
+    auto bound = build(true);
+    auto runtime = build(false);
+    EXPECT_TRUE(vertex_format::PositionTexCoordNormal::matches(runtime));
+    EXPECT_TRUE(bitwiseEqual(bound.assemblyBuffer(), runtime.assemblyBuffer()));
+    EXPECT_TRUE(bitwiseEqual(bound.ExpandIndices(), runtime.ExpandIndices()));
+}
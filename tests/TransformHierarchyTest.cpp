@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include <LayerScene.hpp>
+#include <Node.hpp>
+#include <TransformHierarchy.h>
+
+namespace {
+    constexpr size_t chainDepth{10};
+
+    /**
+     * @brief 给第 i 个节点设置互不相同的平移与非均匀缩放
+     */
+    void configure(Transform& transform, const size_t i) {
+        const auto f = static_cast<float>(i);
+        transform.setTranslate({f, 0.5f * f, -1.0f});
+        transform.setScale({1.0f + 0.1f * f, 1.0f, 0.5f});
+    }
+
+    /**
+     * @brief 深度为 chainDepth 的链, 根节点下另有深度为 2 的分支
+     * @details 返回链上按深度排列的节点[下标 0 为根节点]
+     */
+    template<typename Tree, typename Access>
+    std::vector<Tree*> chain(Tree& root, Access access) {
+        std::vector<Tree*> out{&root};
+        configure(access(root), 0);
+        for (size_t i = 1; i <= chainDepth; i++) {
+            out.push_back(&out.back()->addChild("chain" + std::to_string(i)));
+            configure(access(*out.back()), i);
+        }
+        Tree& side = root.addChild("side");
+        configure(access(side), chainDepth + 1);
+        configure(access(side.addChild("leaf")), chainDepth + 2);
+        return out;
+    }
+
+    /**
+     * @brief 沿 parent 追溯到根节点的变换链[根节点在前]
+     */
+    std::vector<std::reference_wrapper<const Transform>> traceback(LayerSceneElement& element) {
+        std::vector<std::reference_wrapper<const Transform>> out{};
+        LayerSceneElement* e = &element;
+        for (size_t i = 0; i < element.depth(); i++) {
+            out.emplace_back(e->getCommon());
+            e = &e->parent();
+        }
+        out.emplace_back(e->getCommon());
+        std::reverse(out.begin(), out.end());
+        return out;
+    }
+}
+
+TEST(TransformHierarchy, NodeTreeMatchesTraceback) {
+    Node<Transform> root("root");
+    chain(root, [](Node<Transform>& e) -> Transform& { return e.get(); });
+    TransformHierarchy hierarchy{};
+    hierarchy.build(root);
+    ASSERT_EQ(hierarchy.size(), chainDepth + 3);
+    EXPECT_EQ(hierarchy.update(), hierarchy.size());
+    for (auto& e : root.list()) {
+        EXPECT_EQ(hierarchy.world(e.get()), Transform::worldMatrix(e.tracebackToRoot(true))) << e.depth();
+    }
+    // 根节点的追溯链为空, 其世界矩阵为自身的局部矩阵
+    EXPECT_EQ(hierarchy.world(root.get()), root.get().getMatrix());
+}
+
+TEST(TransformHierarchy, LayerSceneMatchesTraceback) {
+    LayerSceneElement root("root");
+    chain(root, [](LayerSceneElement& e) -> Transform& { return e.getCommon(); });
+    TransformHierarchy hierarchy{};
+    hierarchy.build(root, [](LayerSceneElement& e) -> const Transform& { return e.getCommon(); });
+    ASSERT_EQ(hierarchy.size(), chainDepth + 3);
+    hierarchy.update();
+    for (auto& e : root.list()) {
+        EXPECT_EQ(hierarchy.world(e.getCommon()), Transform::worldMatrix(traceback(e))) << e.depth();
+    }
+    EXPECT_EQ(hierarchy.world(root.getCommon()), root.getCommon().getMatrix());
+}
+
+TEST(TransformHierarchy, UpdatesOnlyChangedSubtree) {
+    Node<Transform> root("root");
+    const auto nodes = chain(root, [](Node<Transform>& e) -> Transform& { return e.get(); });
+    TransformHierarchy hierarchy{};
+    hierarchy.build(root);
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.update(), 0u);
+
+    for (const size_t depth : {chainDepth, size_t{4}, size_t{1}}) {
+        nodes[depth]->get().translate({0.0f, 1.0f, 0.0f});
+        // 深度 k 的节点及其下方的链节点
+        EXPECT_EQ(hierarchy.update(), chainDepth - depth + 1) << depth;
+        EXPECT_EQ(hierarchy.update(), 0u) << depth;
+        for (auto& e : root.list()) {
+            EXPECT_EQ(hierarchy.world(e.get()), Transform::worldMatrix(e.tracebackToRoot(true))) << depth << ' ' << e.depth();
+        }
+    }
+
+    // 根节点变化时整棵树重新计算
+    root.get().translate({1.0f, 0.0f, 0.0f});
+    EXPECT_EQ(hierarchy.update(), hierarchy.size());
+}
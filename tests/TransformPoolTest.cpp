@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <TransformPool.h>
+#include <glm/glm.hpp>
+
+namespace {
+    constexpr size_t transformCount{1000};
+
+    /**
+     * @brief 确定的伪随机变换参数
+     * @details 位置与原点 [-100, 100], 非均匀缩放 [0.2, 5], 旋转为归一化的随机四元数
+     */
+    struct Parameters {
+        glm::vec3 position, scale, origin;
+        glm::quat rotation;
+    };
+
+    std::vector<Parameters> randomParameters() {
+        uint32_t state{2024};
+        auto next = [&](const float low, const float high) {
+            state = state * 1664525u + 1013904223u;
+            return low + (high - low) * static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+        };
+        std::vector<Parameters> out(transformCount);
+        for (auto& e : out) {
+            e.position = {next(-100.0f, 100.0f), next(-100.0f, 100.0f), next(-100.0f, 100.0f)};
+            e.scale = {next(0.2f, 5.0f), next(0.2f, 5.0f), next(0.2f, 5.0f)};
+            e.origin = {next(-100.0f, 100.0f), next(-100.0f, 100.0f), next(-100.0f, 100.0f)};
+            const float x = next(-1.0f, 1.0f), y = next(-1.0f, 1.0f), z = next(-1.0f, 1.0f), w = next(-1.0f, 1.0f);
+            const float length = std::sqrt(x * x + y * y + z * z + w * w);
+            e.rotation = glm::quat(w / length, x / length, y / length, z / length);
+        }
+        return out;
+    }
+
+    std::vector<TransformPool::Handle> fill(TransformPool& pool, const std::vector<Parameters>& parameters, const bool inverse) {
+        std::vector<TransformPool::Handle> out{};
+        for (const auto& e : parameters) {
+            const auto handle = pool.allocate();
+            pool.setPosition(handle, e.position);
+            pool.setRotation(handle, e.rotation);
+            pool.setScale(handle, e.scale);
+            pool.setOrigin(handle, e.origin);
+            pool.setInverse(handle, inverse);
+            out.push_back(handle);
+        }
+        return out;
+    }
+
+    /**
+     * @brief 以矩阵各元素量级归一化的最大偏差
+     */
+    float maxDeviation(const glm::mat4& a, const glm::mat4& b) {
+        float out{0.0f};
+        for (int c = 0; c < 4; c++) {
+            for (int r = 0; r < 4; r++) {
+                out = std::max(out, std::fabs(a[c][r] - b[c][r]) / std::max(1.0f, std::fabs(b[c][r])));
+            }
+        }
+        return out;
+    }
+}
+
+TEST(TransformPoolInverse, ProductIsIdentity) {
+    const auto parameters = randomParameters();
+    TransformPool forward{}, inverse{};
+    const auto forwardHandles = fill(forward, parameters, false);
+    const auto inverseHandles = fill(inverse, parameters, true);
+    forward.update();
+    inverse.update();
+    float linear{0.0f}, translation{0.0f};
+    for (size_t i = 0; i < transformCount; i++) {
+        const glm::mat4 product = forward.matrix(forwardHandles[i]) * inverse.matrix(inverseHandles[i]);
+        for (int c = 0; c < 3; c++) {
+            for (int r = 0; r < 4; r++) {
+                linear = std::max(linear, std::fabs(product[c][r] - (c == r ? 1.0f : 0.0f)));
+            }
+        }
+        // 平移列的舍入误差与位置和原点的量级成正比
+        const auto& e = parameters[i];
+        const float reach = 1.0f + glm::length(e.position) + glm::length(e.origin);
+        for (int r = 0; r < 3; r++) {
+            translation = std::max(translation, std::fabs(product[3][r]) / reach);
+        }
+        EXPECT_EQ(product[3][3], 1.0f);
+    }
+    EXPECT_LE(linear, 1e-5f);
+    EXPECT_LE(translation, 4e-6f);
+}
+
+TEST(TransformPoolInverse, MatchesGeneralInverse) {
+    const auto parameters = randomParameters();
+    TransformPool forward{}, inverse{};
+    const auto forwardHandles = fill(forward, parameters, false);
+    const auto inverseHandles = fill(inverse, parameters, true);
+    forward.update();
+    inverse.update();
+    float error{0.0f};
+    for (size_t i = 0; i < transformCount; i++) {
+        error = std::max(error, maxDeviation(inverse.matrix(inverseHandles[i]), glm::inverse(forward.matrix(forwardHandles[i]))));
+    }
+    EXPECT_LE(error, 1e-4f);
+}
+
+TEST(TransformPoolInverse, BatchMatchesScalar) {
+    const auto parameters = randomParameters();
+    TransformPool batch{}, scalar{};
+    const auto batchHandles = fill(batch, parameters, true);
+    const auto scalarHandles = fill(scalar, parameters, true);
+    batch.update();
+    for (size_t i = 0; i < transformCount; i++) {
+        // 脏槽位由 matrix 以标量路径单独合成
+        EXPECT_LE(maxDeviation(batch.matrix(batchHandles[i]), scalar.matrix(scalarHandles[i])), 1e-6f) << i;
+    }
+}
+
+TEST(TransformPoolInverse, Matrix3x4MatchesMatrix4x4) {
+    const auto parameters = randomParameters();
+    for (const bool inverted : {false, true}) {
+        TransformPool full(TransformPool::Storage::Matrix4x4), packed(TransformPool::Storage::Matrix3x4);
+        const auto fullHandles = fill(full, parameters, inverted);
+        const auto packedHandles = fill(packed, parameters, inverted);
+        full.update();
+        packed.update();
+        for (size_t i = 0; i < transformCount; i++) {
+            const float* columns = full.rows(fullHandles[i]);
+            const float* rows = packed.rows(packedHandles[i]);
+            for (size_t r = 0; r < 3; r++) {
+                for (size_t c = 0; c < 4; c++) {
+                    ASSERT_EQ(rows[r * 4 + c], columns[c * 4 + r]) << i;
+                }
+            }
+            EXPECT_EQ(packed.matrix(packedHandles[i]), full.matrix(fullHandles[i])) << i;
+        }
+    }
+}
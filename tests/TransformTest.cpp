@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <utility>
+
+#include <Transform.h>
+
+TEST(TransformHandle, CopyAllocatesIndependentSlot) {
+    TransformPool pool{};
+    Transform a(pool);
+    a.setTranslate({1.0f, 2.0f, 3.0f});
+    Transform b(a);
+    EXPECT_NE(a.handle(), b.handle());
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(b.getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+    b.translate({1.0f, 0.0f, 0.0f});
+    EXPECT_EQ(a.getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+}
+
+TEST(TransformHandle, CopyAssignmentKeepsSlotInSamePool) {
+    TransformPool pool{};
+    Transform a(pool), b(pool);
+    a.setScale({2.0f, 2.0f, 2.0f});
+    const auto handle = b.handle();
+    b = a;
+    EXPECT_EQ(b.handle(), handle);
+    EXPECT_EQ(b.getScale(), glm::vec3(2.0f, 2.0f, 2.0f));
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(TransformHandle, CopyAssignmentAcrossPoolsMovesToSourcePool) {
+    TransformPool first{}, second{};
+    Transform a(first), b(second);
+    a.setTranslate({4.0f, 0.0f, 0.0f});
+    b = a;
+    EXPECT_EQ(&b.pool(), &first);
+    EXPECT_EQ(b.getPosition(), glm::vec3(4.0f, 0.0f, 0.0f));
+    EXPECT_EQ(first.size(), 2u);
+    EXPECT_EQ(second.size(), 0u);
+}
+
+TEST(TransformHandle, MoveTransfersSlot) {
+    TransformPool pool{};
+    Transform a(pool);
+    a.setTranslate({1.0f, 0.0f, 0.0f});
+    const auto handle = a.handle();
+    Transform b(std::move(a));
+    EXPECT_EQ(b.handle(), handle);
+    EXPECT_EQ(b.getPosition(), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(pool.size(), 1u);
+}
+
+TEST(TransformHandle, MovedFromIsUsableIdentity) {
+    TransformPool pool{};
+    Transform a(pool);
+    a.setTranslate({1.0f, 0.0f, 0.0f});
+    Transform b(std::move(a));
+    // 被移出的变换仍属于原池, 读取时按需分配新的单位槽位
+    EXPECT_EQ(&a.pool(), &pool);
+    EXPECT_EQ(a.getMatrix(), glm::mat4(1.0f));
+    EXPECT_NE(a.handle(), b.handle());
+    EXPECT_EQ(pool.size(), 2u);
+    a.translate({0.0f, 5.0f, 0.0f});
+    EXPECT_EQ(a.getPosition(), glm::vec3(0.0f, 5.0f, 0.0f));
+    EXPECT_EQ(b.getPosition(), glm::vec3(1.0f, 0.0f, 0.0f));
+}
+
+TEST(TransformHandle, MovedFromCopiesAsIdentityWithoutAllocating) {
+    TransformPool pool{};
+    Transform a(pool), c(pool);
+    c.setTranslate({3.0f, 0.0f, 0.0f});
+    Transform b(std::move(a));
+    Transform d(a);
+    EXPECT_EQ(pool.size(), 2u);
+    c = a;
+    EXPECT_EQ(pool.size(), 1u);
+    EXPECT_EQ(c.getPosition(), glm::vec3(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(d.getRotation(), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+}
+
+TEST(TransformHandle, MoveAssignmentReleasesTargetSlot) {
+    TransformPool pool{};
+    Transform a(pool), b(pool);
+    a.setTranslate({1.0f, 0.0f, 0.0f});
+    const auto handle = a.handle();
+    b = std::move(a);
+    EXPECT_EQ(b.handle(), handle);
+    EXPECT_EQ(b.getPosition(), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(pool.size(), 1u);
+    // 被移出的变换与移动构造后相同, 读取时按需分配新的单位槽位
+    EXPECT_EQ(a.getMatrix(), glm::mat4(1.0f));
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(TransformHandle, MoveAssignmentAcrossPoolsKeepsSourcePool) {
+    TransformPool first{}, second{};
+    Transform a(first), b(second);
+    a.setTranslate({1.0f, 0.0f, 0.0f});
+    b = std::move(a);
+    EXPECT_EQ(&b.pool(), &first);
+    EXPECT_EQ(&a.pool(), &first);
+    EXPECT_EQ(first.size(), 1u);
+    EXPECT_EQ(second.size(), 0u);
+    EXPECT_EQ(b.getPosition(), glm::vec3(1.0f, 0.0f, 0.0f));
+}
+
+TEST(TransformHandle, ReleaseReturnsSlot) {
+    TransformPool pool{};
+    TransformPool::Handle handle{};
+    {
+        Transform a(pool);
+        handle = a.handle();
+        Transform b(std::move(a));
+    }
+    EXPECT_EQ(pool.size(), 0u);
+    const size_t capacity = pool.capacity();
+    Transform c(pool);
+    EXPECT_EQ(c.handle(), handle);
+    EXPECT_EQ(pool.capacity(), capacity);
+}
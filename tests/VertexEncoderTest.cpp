@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include <VertexEncoder.h>
+#include <VertexLayout.hpp>
+
+namespace {
+    constexpr size_t sphereCount{4096};
+
+    /**
+     * @brief 斐波那契球面上的单位法线
+     * @details 混入坐标轴与八面体折叠边上的方向
+     */
+    std::vector<float> sphereNormals() {
+        std::vector<float> out{
+            1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f, 0.0f, -1.0f,
+            0.0f, 0.6f, -0.8f, -0.6f, 0.0f, -0.8f
+        };
+        const float golden = std::numbers::pi_v<float> * (3.0f - std::sqrt(5.0f));
+        for (size_t i = 0; i < sphereCount; i++) {
+            const float z = 1.0f - 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(sphereCount);
+            const float r = std::sqrt(1.0f - z * z);
+            const float a = golden * static_cast<float>(i);
+            out.insert(out.end(), {r * std::cos(a), r * std::sin(a), z});
+        }
+        return out;
+    }
+
+    /**
+     * @brief 位置 + 纹理坐标 + 法线 的点集
+     * @details 位置取值范围 [-20, 80], 纹理坐标取值范围 [0, 4]; 每个顶点各属性唯一, 焊接后顶点数等于点数
+     */
+    VertexLayout<float> points() {
+        std::vector<float> normals = sphereNormals();
+        const size_t count = normals.size() / 3;
+        std::vector<float> positions{}, texCoords{};
+        std::vector<unsigned int> indices{};
+        for (size_t i = 0; i < count; i++) {
+            const float* n = normals.data() + i * 3;
+            positions.insert(positions.end(), {30.0f + 50.0f * n[0], 30.0f + 50.0f * n[1], 30.0f + 50.0f * n[2]});
+            texCoords.insert(texCoords.end(), {2.0f + 2.0f * n[0], 2.0f + 2.0f * n[2]});
+            const auto v = static_cast<unsigned int>(i);
+            indices.insert(indices.end(), {v, v, v});
+        }
+        // 补齐到三角形列表
+        while (indices.size() % 9 != 0) {
+            indices.insert(indices.end(), {0u, 0u, 0u});
+        }
+        return VertexLayout<float>::builder()
+            .appendElement("vertices", 3)
+            .attachSource("vertices", std::move(positions))
+            .appendElement("texCoord", 2)
+            .attachSource("texCoord", std::move(texCoords))
+            .appendElement("normal", 3)
+            .attachSource("normal", std::move(normals))
+            .attachIndices(std::move(indices))
+            .build();
+    }
+
+    float maxNormalError(const std::vector<float>& normals, auto&& roundTrip) {
+        float out{0.0f};
+        for (size_t i = 0; i < normals.size(); i += 3) {
+            const std::array<float, 3> decoded = roundTrip(normals.data() + i);
+            for (size_t c = 0; c < 3; c++) {
+                out = std::max(out, std::fabs(decoded[c] - normals[i + c]));
+            }
+        }
+        return out;
+    }
+}
+
+TEST(VertexEncoderHalf, RoundTripsEveryHalf) {
+    for (uint32_t bits = 0; bits <= 0xFFFFu; bits++) {
+        const auto half = static_cast<uint16_t>(bits);
+        const float value = VertexEncoder::halfToFloat(half);
+        if (std::isnan(value)) {
+            EXPECT_TRUE(std::isnan(VertexEncoder::halfToFloat(VertexEncoder::floatToHalf(value)))) << bits;
+            continue;
+        }
+        ASSERT_EQ(VertexEncoder::floatToHalf(value), half) << bits;
+    }
+}
+
+TEST(VertexEncoderHalf, RelativeErrorWithinHalfUlp) {
+    // 规格化范围内相对误差不超过 2^-11
+    for (float value = 0x1p-14f; value < 65504.0f; value *= 1.0009765f) {
+        const float decoded = VertexEncoder::halfToFloat(VertexEncoder::floatToHalf(value));
+        ASSERT_LE(std::fabs(decoded - value), value * 0x1p-11f) << value;
+        ASSERT_EQ(VertexEncoder::halfToFloat(VertexEncoder::floatToHalf(-value)), -decoded) << value;
+    }
+    EXPECT_TRUE(std::isinf(VertexEncoder::halfToFloat(VertexEncoder::floatToHalf(70000.0f))));
+    EXPECT_EQ(VertexEncoder::halfToFloat(VertexEncoder::floatToHalf(0x1p-26f)), 0.0f);
+}
+
+TEST(VertexEncoderUnorm16, ErrorWithinHalfStep) {
+    const auto layout = points();
+    const auto mesh = VertexEncoder::encode(layout, {VertexEncoder::PositionEncoding::Unorm16Bounds, VertexEncoder::TexCoordEncoding::Unorm16Bounds, VertexEncoder::NormalEncoding::Float32});
+    const auto error = VertexEncoder::maxError(layout, mesh);
+    ASSERT_EQ(error.size(), 3u);
+    // 取值范围 / 65535 / 2, 另加解码乘加的 float 舍入
+    EXPECT_LE(error[0], 0.5f * 100.0f / 65535.0f + 80.0f * 0x1p-23f);
+    EXPECT_LE(error[1], 0.5f * 4.0f / 65535.0f + 4.0f * 0x1p-23f);
+    EXPECT_EQ(error[2], 0.0f);
+}
+
+TEST(VertexEncoderHalf, LayoutErrorWithinHalfUlp) {
+    const auto layout = points();
+    const auto mesh = VertexEncoder::encode(layout, {VertexEncoder::PositionEncoding::Half, VertexEncoder::TexCoordEncoding::Half, VertexEncoder::NormalEncoding::Float32});
+    const auto error = VertexEncoder::maxError(layout, mesh);
+    ASSERT_EQ(error.size(), 3u);
+    EXPECT_LE(error[0], 80.0f * 0x1p-11f);
+    EXPECT_LE(error[1], 4.0f * 0x1p-11f);
+}
+
+TEST(VertexEncoderOctahedral, UnitNormalsRoundTrip) {
+    const auto normals = sphereNormals();
+    const float error = maxNormalError(normals, [](const float* n) {
+        return VertexEncoder::decodeOctahedral(VertexEncoder::encodeOctahedral(n));
+    });
+    // 每分量量化步长 1 / 32767, 八面体展开后放大不超过 2 倍
+    EXPECT_LE(error, 2.0f / 32767.0f);
+    EXPECT_EQ(VertexEncoder::encodeOctahedral(std::array<float, 3>{}.data()), (std::array<int16_t, 2>{0, 0}));
+
+    const auto layout = points();
+    const auto mesh = VertexEncoder::encode(layout, {VertexEncoder::PositionEncoding::Float32, VertexEncoder::TexCoordEncoding::Float32, VertexEncoder::NormalEncoding::Octahedral16});
+    EXPECT_LE(VertexEncoder::maxError(layout, mesh)[2], 2.0f / 32767.0f);
+}
+
+TEST(VertexEncoderSnorm1010102, UnitNormalsRoundTrip) {
+    const auto normals = sphereNormals();
+    const float error = maxNormalError(normals, [](const float* n) {
+        return VertexEncoder::decodeSnorm1010102(VertexEncoder::encodeSnorm1010102(n));
+    });
+    EXPECT_LE(error, 0.5f / 511.0f + 0x1p-20f);
+    const std::array<float, 3> extremes{-1.0f, 1.0f, -1.0f};
+    EXPECT_EQ(VertexEncoder::decodeSnorm1010102(VertexEncoder::encodeSnorm1010102(extremes.data())), extremes);
+
+    const auto layout = points();
+    const auto mesh = VertexEncoder::encode(layout, {VertexEncoder::PositionEncoding::Float32, VertexEncoder::TexCoordEncoding::Float32, VertexEncoder::NormalEncoding::Snorm1010102});
+    EXPECT_LE(VertexEncoder::maxError(layout, mesh)[2], 0.5f / 511.0f + 0x1p-20f);
+}
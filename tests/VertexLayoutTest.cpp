@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cstring>
+
+#include <ModelParser.h>
+#include <VertexLayout.hpp>
+
+namespace {
+    /**
+     * @brief 按焊接索引展开焊接缓冲区
+     */
+    std::vector<float> unweld(const VertexLayout<float>& layout) {
+        const std::vector<float>& welded = layout.WeldIndices();
+        const size_t stride = layout.elements()[0].step / sizeof(float);
+        std::vector<float> out{};
+        out.reserve(layout.bufferOfIndices().size() * stride);
+        for (const unsigned int i : layout.bufferOfIndices()) {
+            out.insert(out.end(), welded.begin() + i * stride, welded.begin() + (i + 1) * stride);
+        }
+        return out;
+    }
+
+    bool bitwiseEqual(const std::vector<float>& a, const std::vector<float>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    /**
+     * @brief 2 x 2 个格子的网格
+     * @details 9 个位置, 每个面角引用同号的纹理坐标与唯一的法线, 共 24 个面角 9 个唯一顶点; 法线含 -0.0f 以检验逐位比较
+     */
+    VertexLayout<float> grid() {
+        std::vector<float> positions{}, texCoords{};
+        for (int y = 0; y < 3; y++) {
+            for (int x = 0; x < 3; x++) {
+                positions.insert(positions.end(), {static_cast<float>(x), 0.0f, static_cast<float>(y)});
+                texCoords.insert(texCoords.end(), {static_cast<float>(x) / 2.0f, static_cast<float>(y) / 2.0f});
+            }
+        }
+        std::vector<unsigned int> indices{};
+        for (unsigned int y = 0; y < 2; y++) {
+            for (unsigned int x = 0; x < 2; x++) {
+                const unsigned int a = y * 3 + x, b = a + 1, c = a + 3, d = c + 1;
+                for (const unsigned int e : {a, c, b, b, c, d}) {
+                    indices.insert(indices.end(), {e, e, 0u});
+                }
+            }
+        }
+        return VertexLayout<float>::builder()
+            .appendElement("vertices", 3)
+            .attachSource("vertices", std::move(positions))
+            .appendElement("texCoord", 2)
+            .attachSource("texCoord", std::move(texCoords))
+            .appendElement("normal", 3)
+            .attachSource("normal", std::vector<float>{-0.0f, 1.0f, 0.0f})
+            .attachIndices(std::move(indices))
+            .build();
+    }
+}
+
+TEST(VertexLayoutWeld, ReproducesExpandedMesh) {
+    auto layout = grid();
+    const std::vector<float> expanded = layout.ExpandIndices();
+    EXPECT_TRUE(bitwiseEqual(unweld(layout), expanded));
+    EXPECT_EQ(layout.WeldIndices().size(), 9u * 8u);
+    EXPECT_EQ(layout.bufferOfIndices().size(), 24u);
+    EXPECT_EQ(layout.assemblyMode(), VertexLayout<float>::AssemblyMode::Weld);
+}
+
+TEST(VertexLayoutWeld, SixteenBitIndicesMatch) {
+    auto layout = grid();
+    layout.WeldIndices();
+    const auto& indices = layout.bufferOfIndices();
+    const auto& indices16 = layout.bufferOfIndices16();
+    ASSERT_EQ(indices16.size(), indices.size());
+    EXPECT_TRUE(std::equal(indices.begin(), indices.end(), indices16.begin()));
+}
+
+TEST(VertexLayoutWeld, KeepsBitwiseDistinctVertices) {
+    // 位置相同但法线分别为 0.0f 与 -0.0f 的面角不可合并
+    auto layout = VertexLayout<float>::builder()
+        .appendElement("vertices", 3)
+        .attachSource("vertices", std::vector<float>{0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f})
+        .appendElement("normal", 3)
+        .attachSource("normal", std::vector<float>{0.0f, 0.0f, 1.0f, -0.0f, 0.0f, 1.0f})
+        .attachIndices(std::vector<unsigned int>{0, 0, 1, 0, 2, 0, 0, 1, 1, 1, 2, 1})
+        .build();
+    const std::vector<float> expanded = layout.ExpandIndices();
+    EXPECT_TRUE(bitwiseEqual(unweld(layout), expanded));
+    EXPECT_EQ(layout.WeldIndices().size(), 6u * 6u);
+}
+
+TEST(VertexLayoutWeld, PartialUpdateMatchesRebuild) {
+    auto layout = grid();
+    layout.WeldIndices();
+    ASSERT_TRUE(layout["vertices"].updateSource(4, std::vector<float>{1.0f, 0.5f, 1.0f}));
+    const std::vector<float> patched = unweld(layout);
+
+    auto rebuilt = grid();
+    ASSERT_TRUE(rebuilt["vertices"].updateSource(4, std::vector<float>{1.0f, 0.5f, 1.0f}));
+    EXPECT_TRUE(bitwiseEqual(patched, rebuilt.ExpandIndices()));
+}
+
+TEST(VertexLayoutWeld, ReproducesParsedModel) {
+    auto models = ModelParser::ObjModelLoader(std::filesystem::path(RESOURCE_DIR) / "model/default.obj");
+    ASSERT_FALSE(models.empty());
+    size_t expandedSize{0}, weldedSize{0};
+    for (auto& [name, layout] : models) {
+        if (layout.rawIndices().empty()) continue;
+        const std::vector<float> expanded = layout.ExpandIndices();
+        EXPECT_TRUE(bitwiseEqual(unweld(layout), expanded)) << name;
+        expandedSize += expanded.size();
+        weldedSize += layout.WeldIndices().size();
+    }
+    EXPECT_LT(weldedSize * 2, expandedSize);
+}
+
+namespace {
+    using ByteRange = VertexLayout<float>::ByteRange;
+
+    void expectRanges(const std::vector<ByteRange>& actual, const std::vector<ByteRange>& expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            EXPECT_EQ(actual[i].offset, expected[i].offset) << i;
+            EXPECT_EQ(actual[i].size, expected[i].size) << i;
+        }
+    }
+
+    /**
+     * @brief 更新首尾两个位置并重新组装
+     * @details 返回组装前清除过的字节区间
+     */
+    template<typename Assemble>
+    const std::vector<ByteRange>& updateEnds(VertexLayout<float>& layout, size_t last, Assemble assemble) {
+        assemble(layout);
+        layout.clearDirtyRanges();
+        EXPECT_TRUE(layout["vertices"].updateSource(0, std::vector<float>{-1.0f, -1.0f, -1.0f}));
+        EXPECT_TRUE(layout["vertices"].updateSource(last, std::vector<float>{9.0f, 9.0f, 9.0f}));
+        assemble(layout);
+        return layout.dirtyRanges();
+    }
+}
+
+TEST(VertexLayoutDirty, SequentialReportsSeparateRanges) {
+    std::vector<float> positions(8 * 3, 0.0f), texCoords(8 * 2, 0.0f);
+    auto layout = VertexLayout<float>::builder()
+        .appendElement("vertices", 3)
+        .attachSource("vertices", std::move(positions))
+        .appendElement("texCoord", 2)
+        .attachSource("texCoord", std::move(texCoords))
+        .build();
+    // 步长 20 字节, 位置占每个顶点的前 12 字节
+    expectRanges(updateEnds(layout, 7, [](auto& e) { e.assemblyBuffer(); }), {{0, 12}, {140, 12}});
+    EXPECT_EQ(layout.assemblyBuffer()[7 * 5], 9.0f);
+
+    // 相接的顶点区间合并
+    layout.clearDirtyRanges();
+    ASSERT_TRUE(layout["vertices"].updateSource(3, std::vector<float>{1.0f, 1.0f, 1.0f}));
+    ASSERT_TRUE(layout["vertices"].updateSource(4, std::vector<float>{1.0f, 1.0f, 1.0f}));
+    layout.assemblyBuffer();
+    expectRanges(layout.dirtyRanges(), {{60, 32}});
+}
+
+TEST(VertexLayoutDirty, ExpandReportsSeparateRanges) {
+    auto layout = grid();
+    // 位置 0 仅被面角 0 引用, 位置 8 仅被面角 23 引用, 步长 32 字节
+    expectRanges(updateEnds(layout, 8, [](auto& e) { e.ExpandIndices(); }), {{0, 12}, {23 * 32, 12}});
+}
+
+TEST(VertexLayoutDirty, WeldReportsSeparateRanges) {
+    auto layout = grid();
+    // 焊接后位置 0 与位置 8 分别为首个与末个唯一顶点
+    expectRanges(updateEnds(layout, 8, [](auto& e) { e.WeldIndices(); }), {{0, 12}, {8 * 32, 12}});
+    const std::vector<float> patched = unweld(layout);
+    EXPECT_TRUE(bitwiseEqual(patched, layout.ExpandIndices()));
+}